@@ -20,6 +20,7 @@
 #include "actionresultviewer.h"
 #include "app/common.h"
 #include "cli/clicall.h"
+#include "cli/climetrics.h"
 
 #include <QFileInfo>
 
@@ -47,6 +48,7 @@ uint qHash(Action::Flow key, uint seed)
 Action::Action(Action::Flow scope, int type, QObject *parent, const Action::Id &id)
     : QObject(parent)
     , m_id(id.isNull() ? QUuid::createUuid() : id)
+    , m_metricsId()
     , m_scope(scope)
     , m_type(type)
     , m_title()
@@ -55,6 +57,7 @@ Action::Action(Action::Flow scope, int type, QObject *parent, const Action::Id &
     , m_timeout(CLICall::DefaultTimeoutMSecs)
     , m_forceShow(false)
     , m_menuPlace(MenuPlace::NoMenu)
+    , m_outputStreamed(false)
 {
     if (-1 == MetaIdId) {
         MetaIdId = qRegisterMetaType<Action::Id>("Action::Id");
@@ -88,6 +91,16 @@ Action::Id Action::id() const
     return m_id;
 }
 
+Action::Id Action::metricsId() const
+{
+    return m_metricsId.isNull() ? m_id : m_metricsId;
+}
+
+void Action::setMetricsId(const Action::Id &id)
+{
+    m_metricsId = id;
+}
+
 QString Action::title() const
 {
     return m_title;
@@ -162,6 +175,7 @@ CLICall *Action::createRequest()
     auto call = new CLICall(app(), args(), timeout(), this);
     this->QObject::connect(call, &CLICall::ready, this, &Action::onResult);
     this->QObject::connect(call, &CLICall::starting, this, &Action::onStart);
+    this->QObject::connect(call, &CLICall::lineReady, this, &Action::onOutputLine);
 
     return call;
 }
@@ -189,9 +203,16 @@ CLICall *Action::createRequest()
 
 void Action::onStart(const QString &app, const QStringList &args)
 {
+    m_outputStreamed = false;
     emit performing(id(), app, args);
 }
 
+void Action::onOutputLine(const QString &line)
+{
+    m_outputStreamed = true;
+    emit outputLine(id(), line);
+}
+
 void Action::onResult(const QString &result)
 {
     int exitCode(0);
@@ -203,11 +224,27 @@ void Action::onResult(const QString &result)
         const QString &errReport = call->errors();
         errors = errReport.isEmpty() ? errors : errReport;
         hasErrors = call->exitCode() != 0 || call->exitStatus() != QProcess::NormalExit || !errReport.isEmpty();
+
+        switch (call->origin()) {
+        case CLICall::Origin::Cache:
+            CLIMetrics::instance()->recordCacheHit(metricsId(), title());
+            break;
+        case CLICall::Origin::Coalesced:
+            CLIMetrics::instance()->recordCoalesced(metricsId(), title());
+            break;
+        default: {
+            const CLICall::Timings &timings = call->timings();
+            CLIMetrics::instance()->record(metricsId(), title(),
+                                           { timings.spawnMs, timings.firstByteMs, timings.totalMs,
+                                             timings.bytesRead, call->exitCode(), call->exitStatus(), !hasErrors });
+            break;
+        }
+        }
         call->deleteLater();
     }
 
     QString info = QString("%1 ").arg(YANGL_TIMESTAMP);
-    if (!result.isEmpty()) {
+    if (!result.isEmpty() && !m_outputStreamed) {
         info.append(QString("<b>Result:</b><br>%1<br>").arg(QString(result).replace("\n", "<br>")));
     }
     if (exitCode) {
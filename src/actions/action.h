@@ -84,7 +84,8 @@ public:
         ShowLog,
         Activated,
         ShowAbout,
-        Quit
+        Quit,
+        ExportHistory
     };
     Q_ENUM(Yangl);
 
@@ -98,6 +99,10 @@ public:
     virtual ~Action();
     Id id() const;
 
+    // actions doing the same job (e.g. the servers list workers) share their CLI metrics under this id
+    Id metricsId() const;
+    void setMetricsId(const Id &id);
+
     virtual Action::Flow scope() const;
     virtual int type() const;
 
@@ -134,6 +139,7 @@ public:
 signals:
     void performing(const Action::Id &id, const QString &app, const QStringList &args);
     void performed(const Action::Id &id, const QString &result, bool ok, const QString &description);
+    void outputLine(const Action::Id &id, const QString &line);
     void changed();
 
     void titleChanged(const QString &title);
@@ -146,6 +152,7 @@ signals:
 protected slots:
     virtual void onStart(const QString &app, const QStringList &args);
     virtual void onResult(const QString &result);
+    virtual void onOutputLine(const QString &line);
 
 protected:
     friend class ActionStorage;
@@ -159,6 +166,7 @@ protected:
     explicit Action(Action::Flow scope, int type, QObject *parent = {}, const Action::Id &id = {});
 
     const Action::Id m_id;
+    Action::Id m_metricsId;
     const Action::Flow m_scope;
     const int m_type;
 
@@ -169,6 +177,7 @@ protected:
     bool m_forceShow;
     QPointer<QTextBrowser> m_display;
     MenuPlace m_menuPlace;
+    bool m_outputStreamed;
 };
 
 Q_DECLARE_METATYPE(Action::MenuPlace);
@@ -18,10 +18,15 @@
 #include "actionresultviewer.h"
 
 #include "app/common.h"
+#include "cli/climetrics.h"
 #include "settings/appsettings.h"
 
 #include <QGridLayout>
+#include <QHeaderView>
+#include <QPushButton>
+#include <QTabBar>
 #include <QTabWidget>
+#include <QTreeWidget>
 
 /*static*/ ActionResultViewer *ActionResultViewer::m_instance = {};
 /*static*/ int ActionResultViewer::m_linesLimit = CLICallResultView::MaxBlocksCountDefault;
@@ -29,16 +34,34 @@
 ActionResultViewer::ActionResultViewer()
     : QWidget()
     , m_tabWidget(new QTabWidget(this))
+    , m_metricsPage(nullptr)
+    , m_metricsView(nullptr)
 {
     m_tabWidget->setTabsClosable(true);
     connect(m_tabWidget, &QTabWidget::tabCloseRequested, this, [this](int index) {
         QWidget *tab = m_tabWidget->widget(index);
+        if (tab == m_metricsPage)
+            return;
         m_tabWidget->removeTab(index);
         tab->close();
     });
     QGridLayout *layout = new QGridLayout(this);
     layout->addWidget(m_tabWidget);
 
+    m_metricsPage = createMetricsPage();
+    const int metricsTab = m_tabWidget->addTab(m_metricsPage, tr("Metrics"));
+    m_tabWidget->tabBar()->setTabButton(metricsTab, QTabBar::RightSide, nullptr);
+    m_tabWidget->tabBar()->setTabButton(metricsTab, QTabBar::LeftSide, nullptr);
+
+    connect(m_tabWidget, &QTabWidget::currentChanged, this, [this](int index) {
+        if (m_tabWidget->widget(index) == m_metricsPage)
+            refreshMetrics();
+    });
+    connect(CLIMetrics::instance(), &CLIMetrics::updated, this, [this]() {
+        if (isVisible() && m_tabWidget->currentWidget() == m_metricsPage)
+            refreshMetrics();
+    });
+
     setWindowTitle(utils::composeTitle("CLI Log"));
 }
 
@@ -64,6 +87,7 @@ ActionResultViewer::ActionResultViewer()
 
     connect(action, &Action::performing, instance(), &ActionResultViewer::onActionStarted, Qt::UniqueConnection);
     connect(action, &Action::performed, instance(), &ActionResultViewer::onActionPerformed, Qt::UniqueConnection);
+    connect(action, &Action::outputLine, instance(), &ActionResultViewer::onActionOutput, Qt::UniqueConnection);
 }
 
 /*static*/ void ActionResultViewer::unregisterAction(Action *action)
@@ -72,6 +96,7 @@ ActionResultViewer::ActionResultViewer()
         return;
 
     disconnect(action, &Action::performed, instance(), &ActionResultViewer::onActionPerformed);
+    disconnect(action, &Action::outputLine, instance(), &ActionResultViewer::onActionOutput);
     instance()->m_actions.remove(action->id());
 }
 
@@ -82,6 +107,16 @@ void ActionResultViewer::onActionStarted(const Action::Id &id, const QString & /
             display->append(tr("%1 <b>Calling</b>…").arg(YANGL_TIMESTAMP));
 }
 
+void ActionResultViewer::onActionOutput(const Action::Id &id, const QString &line)
+{
+    if (line.isEmpty())
+        return;
+
+    if (auto action = m_actions.value(id))
+        if (auto display = displayForAction(action))
+            display->append(line.toHtmlEscaped());
+}
+
 void ActionResultViewer::onActionPerformed(const Action::Id &id, const QString & /*result*/, bool ok,
                                            const QString &info)
 {
@@ -122,6 +157,71 @@ CLICallResultView *ActionResultViewer::displayForAction(Action *action)
     return m_browsers.value(id, {});
 }
 
+QWidget *ActionResultViewer::createMetricsPage()
+{
+    QWidget *page = new QWidget(this);
+
+    m_metricsView = new QTreeWidget(page);
+    m_metricsView->setRootIsDecorated(false);
+    m_metricsView->setSortingEnabled(true);
+    m_metricsView->setHeaderLabels({ tr("Action"), tr("Calls"), tr("Failed"), tr("Cached"), tr("Coalesced"),
+                                     tr("Spawn p50/p95, ms"), tr("First byte p50/p95, ms"), tr("Total p50/p95, ms"),
+                                     tr("Total max, ms"), tr("Bytes read") });
+    m_metricsView->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+    QPushButton *buttonRefresh = new QPushButton(tr("Refresh"), page);
+    QPushButton *buttonDump = new QPushButton(tr("Dump JSON"), page);
+    buttonDump->setToolTip(CLIMetrics::defaultDumpPath());
+    connect(buttonRefresh, &QPushButton::clicked, this, &ActionResultViewer::refreshMetrics);
+    connect(buttonDump, &QPushButton::clicked, this, &ActionResultViewer::dumpMetrics);
+
+    QGridLayout *layout = new QGridLayout(page);
+    layout->addWidget(m_metricsView, 0, 0, 1, 3);
+    layout->addWidget(buttonRefresh, 1, 1);
+    layout->addWidget(buttonDump, 1, 2);
+    layout->setColumnStretch(0, 1);
+
+    return page;
+}
+
+void ActionResultViewer::refreshMetrics()
+{
+    auto percentiles = [](const CLIMetrics::Histogram &histogram) {
+        return histogram.count() ? QString("%1 / %2").arg(histogram.percentile(0.5)).arg(histogram.percentile(0.95))
+                                 : QStringLiteral("—");
+    };
+
+    m_metricsView->setSortingEnabled(false);
+    m_metricsView->clear();
+
+    const CLIMetrics *metrics = CLIMetrics::instance();
+    const QList<QUuid> &ids = metrics->ids();
+    for (const auto &id : ids) {
+        const CLIMetrics::Entry &entry = metrics->entry(id);
+        QTreeWidgetItem *item = new QTreeWidgetItem(m_metricsView);
+        item->setText(0, entry.title.isEmpty() ? id.toString(QUuid::WithoutBraces) : entry.title);
+        item->setToolTip(0, id.toString(QUuid::WithoutBraces));
+        item->setData(1, Qt::DisplayRole, static_cast<qulonglong>(entry.calls));
+        item->setData(2, Qt::DisplayRole, static_cast<qulonglong>(entry.failures));
+        item->setData(3, Qt::DisplayRole, static_cast<qulonglong>(entry.cacheHits));
+        item->setData(4, Qt::DisplayRole, static_cast<qulonglong>(entry.coalesced));
+        item->setText(5, percentiles(entry.spawn));
+        item->setText(6, percentiles(entry.firstByte));
+        item->setText(7, percentiles(entry.total));
+        item->setData(8, Qt::DisplayRole, entry.total.max());
+        item->setData(9, Qt::DisplayRole, static_cast<qulonglong>(entry.bytesRead));
+    }
+
+    m_metricsView->setSortingEnabled(true);
+}
+
+void ActionResultViewer::dumpMetrics()
+{
+    const QString &path = CLIMetrics::defaultDumpPath();
+    if (CLIMetrics::instance()->dump(path))
+        LOG << "CLI metrics saved to" << path;
+}
+
 /*static*/ void ActionResultViewer::updateLinesLimit()
 {
     const int newLimit = AppSettings::Monitor->LogLinesLimit->read().toInt();
@@ -25,6 +25,7 @@
 #include <QWidget>
 
 class QTabWidget;
+class QTreeWidget;
 class ActionResultViewer : public QWidget
 {
     Q_OBJECT
@@ -37,6 +38,9 @@ public:
 private slots:
     void onActionStarted(const Action::Id &id, const QString &app, const QStringList &args);
     void onActionPerformed(const Action::Id &id, const QString &result, bool ok, const QString &info);
+    void onActionOutput(const Action::Id &id, const QString &line);
+    void refreshMetrics();
+    void dumpMetrics();
 
 private:
     static ActionResultViewer *instance();
@@ -45,8 +49,11 @@ private:
 
     explicit ActionResultViewer();
     QTabWidget *m_tabWidget;
+    QWidget *m_metricsPage;
+    QTreeWidget *m_metricsView;
 
     QMap<Action::Id, QPointer<Action>> m_actions;
     QMap<Action::Id, QPointer<CLICallResultView>> m_browsers;
     CLICallResultView *displayForAction(Action *action);
+    QWidget *createMetricsPage();
 };
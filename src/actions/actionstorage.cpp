@@ -253,6 +253,9 @@ Action::Ptr ActionStorage::createYanglAction(Action::Yangl actionType, const QSt
         title = tr("Quit");
         anchor = Action::MenuPlace::Common;
         break;
+    case Action::Yangl::ExportHistory:
+        title = tr("Export history…");
+        break;
     }
 
     const Action::Flow scope = Action::Flow::Yangl;
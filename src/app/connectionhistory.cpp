@@ -0,0 +1,217 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "connectionhistory.h"
+
+#include <QDateTime>
+#include <QIODevice>
+#include <QTextStream>
+#include <QTimeZone>
+
+ConnectionHistory::ConnectionHistory(qsizetype recentCapacity, qsizetype archiveCapacity, int downsampleFactor,
+                                     QObject *parent)
+    : QObject(parent)
+    , m_recent(recentCapacity)
+    , m_archive(archiveCapacity)
+    , m_downsampleFactor(qMax(1, downsampleFactor))
+    , m_bucket()
+    , m_bucketCount(0)
+    , m_revision(0)
+{
+    resetServers();
+}
+
+ConnectionHistory::Sample ConnectionHistory::sampleFrom(const NordVpnInfo &state, qint64 timestampMs)
+{
+    Sample sample;
+    sample.timestampMs = timestampMs;
+    sample.status = state.status();
+    sample.server = internServer(state);
+    sample.rxBytes = state.rxBytes();
+    sample.txBytes = state.txBytes();
+    if (state.hasUptime()) {
+        sample.uptimeSecs = static_cast<quint32>(qMin<qint64>(state.uptime().count(), NoUptime - 1));
+    }
+    return sample;
+}
+
+quint32 ConnectionHistory::internServer(const NordVpnInfo &state)
+{
+    // the ids are never reused, the same one is the same server as the last sample
+    const quint32 serverId = state.serverId();
+    if (serverId == m_lastServerId) {
+        return m_lastServer;
+    }
+
+    const QString &name = state.server();
+    quint32 server(0);
+    if (!name.isEmpty()) {
+        const auto it = m_serverIndices.constFind(name);
+        if (it != m_serverIndices.cend()) {
+            server = it.value();
+        } else {
+            server = static_cast<quint32>(m_servers.size());
+            m_servers.append(name);
+            m_serverIndices.insert(name, server);
+        }
+    }
+
+    m_lastServerId = serverId;
+    m_lastServer = server;
+    return server;
+}
+
+QString ConnectionHistory::serverName(quint32 server) const
+{
+    return m_servers.value(server);
+}
+
+void ConnectionHistory::resetServers()
+{
+    m_servers = { QString() };
+    m_serverIndices.clear();
+    m_lastServerId = 0;
+    m_lastServer = 0;
+}
+
+void ConnectionHistory::append(const NordVpnInfo &state, qint64 timestampMs)
+{
+    Sample evicted;
+    if (m_recent.push(sampleFrom(state, timestampMs), &evicted)) {
+        archive(evicted);
+    }
+    ++m_revision;
+
+    emit appended();
+}
+
+void ConnectionHistory::archive(const Sample &evicted)
+{
+    // a bucket keeps the newest counters but remembers any non-connected state it has seen
+    const bool unstable = m_bucketCount && m_bucket.status != NordVpnInfo::Status::Connected;
+    const NordVpnInfo::Status status = unstable ? m_bucket.status : evicted.status;
+
+    m_bucket = evicted;
+    m_bucket.status = status;
+
+    if (++m_bucketCount >= m_downsampleFactor) {
+        m_archive.push(m_bucket);
+        m_bucket = {};
+        m_bucketCount = 0;
+    }
+}
+
+void ConnectionHistory::clear()
+{
+    m_recent.clear();
+    m_archive.clear();
+    m_bucket = {};
+    m_bucketCount = 0;
+    resetServers();
+    ++m_revision;
+}
+
+qsizetype ConnectionHistory::size() const
+{
+    return m_archive.size() + (m_bucketCount ? 1 : 0) + m_recent.size();
+}
+
+qsizetype ConnectionHistory::recentSize() const
+{
+    return m_recent.size();
+}
+
+qsizetype ConnectionHistory::archiveSize() const
+{
+    return m_archive.size();
+}
+
+int ConnectionHistory::downsampleFactor() const
+{
+    return m_downsampleFactor;
+}
+
+qsizetype ConnectionHistory::memoryUsage() const
+{
+    return sizeof(*this) + (m_recent.capacity() + m_archive.capacity()) * qsizetype(sizeof(Sample));
+}
+
+quint64 ConnectionHistory::revision() const
+{
+    return m_revision;
+}
+
+qsizetype ConnectionHistory::exportCsv(QIODevice *device) const
+{
+    if (!device || !device->isWritable()) {
+        return -1;
+    }
+
+    QTextStream out(device);
+    out << "timestamp,status,server,rx_bytes,tx_bytes,uptime_secs\n";
+
+    qsizetype rows(0);
+    forEach([this, &out, &rows](const Sample &sample) {
+        out << QDateTime::fromMSecsSinceEpoch(sample.timestampMs, QTimeZone::utc()).toString(Qt::ISODateWithMs) << ','
+            << NordVpnInfo::statusToText(sample.status) << ',' << serverName(sample.server) << ','
+            << sample.rxBytes << ',' << sample.txBytes << ',';
+        if (sample.uptimeSecs != NoUptime) {
+            out << sample.uptimeSecs;
+        }
+        out << '\n';
+        ++rows;
+    });
+
+    out.flush();
+    return rows;
+}
+
+QString ConnectionHistory::sparkline(int width) const
+{
+    static constexpr char16_t Bars[] = u"▁▂▃▄▅▆▇█";
+    static constexpr int Levels = 8;
+
+    const qsizetype count = qMin<qsizetype>(m_recent.size(), qsizetype(width) + 1);
+    if (width <= 0 || count < 2) {
+        return {};
+    }
+
+    std::vector<double> rates;
+    rates.reserve(static_cast<size_t>(count - 1));
+    double maxRate(0.);
+    for (qsizetype i = m_recent.size() - count + 1; i < m_recent.size(); ++i) {
+        const Sample &prev = m_recent.at(i - 1);
+        const Sample &curr = m_recent.at(i);
+        const qint64 elapsedMs = curr.timestampMs - prev.timestampMs;
+        const quint64 before = prev.rxBytes + prev.txBytes;
+        const quint64 after = curr.rxBytes + curr.txBytes;
+
+        // counters restart along with the tunnel
+        const double rate = elapsedMs > 0 && after >= before ? (after - before) * 1000. / elapsedMs : 0.;
+        rates.push_back(rate);
+        maxRate = qMax(maxRate, rate);
+    }
+
+    QString line;
+    line.reserve(qsizetype(rates.size()));
+    for (const double rate : rates) {
+        const int level = maxRate > 0. ? qBound(0, int(rate / maxRate * (Levels - 1) + 0.5), Levels - 1) : 0;
+        line.append(QChar(Bars[level]));
+    }
+
+    return line;
+}
@@ -0,0 +1,103 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include "app/nordvpninfo.h"
+#include "app/ringbuffer.h"
+
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <limits>
+
+class QIODevice;
+
+class ConnectionHistory : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr qsizetype DefaultRecentCapacity = 3600;
+    static constexpr qsizetype DefaultArchiveCapacity = 1440;
+    static constexpr int DefaultDownsampleFactor = 60;
+    static constexpr quint32 NoUptime = std::numeric_limits<quint32>::max();
+
+    struct Sample {
+        qint64 timestampMs = 0;
+        quint64 rxBytes = 0;
+        quint64 txBytes = 0;
+        quint32 server = 0; // index in the history's own server names, 0 is none
+        quint32 uptimeSecs = NoUptime;
+        NordVpnInfo::Status status = NordVpnInfo::Status::Unknown;
+    };
+
+    explicit ConnectionHistory(qsizetype recentCapacity = DefaultRecentCapacity,
+                               qsizetype archiveCapacity = DefaultArchiveCapacity,
+                               int downsampleFactor = DefaultDownsampleFactor, QObject *parent = {});
+
+    void append(const NordVpnInfo &state, qint64 timestampMs);
+    void clear();
+
+    qsizetype size() const;
+    qsizetype recentSize() const;
+    qsizetype archiveSize() const;
+    int downsampleFactor() const;
+    // the samples storage, the server names table grows with the distinct servers only
+    qsizetype memoryUsage() const;
+    quint64 revision() const;
+
+    template<typename Visitor>
+    void forEach(Visitor &&visitor) const
+    {
+        for (qsizetype i = 0; i < m_archive.size(); ++i) {
+            visitor(m_archive.at(i));
+        }
+        if (m_bucketCount) {
+            visitor(m_bucket);
+        }
+        for (qsizetype i = 0; i < m_recent.size(); ++i) {
+            visitor(m_recent.at(i));
+        }
+    }
+
+    qsizetype exportCsv(QIODevice *device) const;
+    QString sparkline(int width) const;
+
+    Sample sampleFrom(const NordVpnInfo &state, qint64 timestampMs);
+    QString serverName(quint32 server) const;
+
+signals:
+    void appended();
+
+private:
+    RingBuffer<Sample> m_recent;
+    RingBuffer<Sample> m_archive;
+    const int m_downsampleFactor;
+    Sample m_bucket;
+    int m_bucketCount;
+    quint64 m_revision;
+
+    // NordVpnInfo's server ids are evicted over time, the samples outlive them
+    QStringList m_servers;
+    QHash<QString, quint32> m_serverIndices;
+    quint32 m_lastServerId;
+    quint32 m_lastServer;
+
+    void archive(const Sample &evicted);
+    quint32 internServer(const NordVpnInfo &state);
+    void resetServers();
+};
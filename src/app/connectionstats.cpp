@@ -0,0 +1,371 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "connectionstats.h"
+
+#include "app/common.h"
+#include "app/jsonfilestore.h"
+#include "settings/settingsmanager.h"
+
+#include <QJsonObject>
+#include <QTimer>
+#include <QtMath>
+#include <algorithm>
+
+namespace JsonConsts {
+static const QLatin1String Country { "country" };
+static const QLatin1String City { "city" };
+static const QLatin1String Successes { "successes" };
+static const QLatin1String Failures { "failures" };
+static const QLatin1String Retries { "retries" };
+static const QLatin1String Durations { "durationsMs" };
+};
+
+static constexpr int StatsFormatVersion = 1;
+
+double ConnectionStats::Summary::successRate() const
+{
+    return attempts() ? static_cast<double>(successes) / attempts() : 0.;
+}
+
+QString ConnectionStats::Summary::toString() const
+{
+    if (isEmpty()) {
+        return {};
+    }
+
+    QStringList lines;
+    if (p50Ms >= 0) {
+        lines.append(QObject::tr("Connects in %1 s (p90: %2 s)")
+                             .arg(p50Ms / 1000., 0, 'f', 1)
+                             .arg(p90Ms / 1000., 0, 'f', 1));
+    }
+    lines.append(QObject::tr("Succeeded %1 of %2 (%3%)")
+                         .arg(successes)
+                         .arg(attempts())
+                         .arg(qRound(successRate() * 100)));
+    if (retries) {
+        lines.append(QObject::tr("Retries: %1").arg(retries));
+    }
+
+    return lines.join(QLatin1Char('\n'));
+}
+
+ConnectionStats::ConnectionStats(const QString &filePath, QObject *parent)
+    : QObject(parent)
+    , m_store(new JsonFileStore(filePath, StatsFormatVersion, this))
+    , m_status(NordVpnInfo::Status::Unknown)
+    , m_timeoutTimer(new QTimer(this))
+{
+    m_timeoutTimer->setSingleShot(true);
+    m_timeoutTimer->setInterval(DefaultTimeoutMs);
+    connect(m_timeoutTimer, &QTimer::timeout, this, &ConnectionStats::fail);
+
+    m_store->setWriter([this]() { return toJson(); });
+}
+
+ConnectionStats::~ConnectionStats()
+{
+    m_store->flush();
+}
+
+/*static*/ QString ConnectionStats::defaultFilePath()
+{
+    return QString("%1/connection_stats.json").arg(SettingsManager::dirPath());
+}
+
+QString ConnectionStats::filePath() const
+{
+    return m_store->filePath();
+}
+
+void ConnectionStats::setTimeout(int ms)
+{
+    m_timeoutTimer->setInterval(qMax(1, ms));
+}
+
+int ConnectionStats::timeout() const
+{
+    return m_timeoutTimer->interval();
+}
+
+/*static*/ QString ConnectionStats::normalized(const QString &name)
+{
+    return QString(name).replace(QLatin1Char('_'), QLatin1Char(' ')).simplified();
+}
+
+/*static*/ QString ConnectionStats::key(const QString &country, const QString &city)
+{
+    return normalized(country).toCaseFolded() + QChar(0x1f) + normalized(city).toCaseFolded();
+}
+
+ConnectionStats::Record &ConnectionStats::record(const QString &country, const QString &city)
+{
+    Record &rec = m_records[key(country, city)];
+    if (rec.country.isEmpty()) {
+        rec.country = normalized(country);
+        rec.city = normalized(city);
+    }
+    return rec;
+}
+
+bool ConnectionStats::isPending() const
+{
+    return m_pending.startedMs >= 0;
+}
+
+void ConnectionStats::begin(const QString &country, const QString &city, qint64 timestampMs)
+{
+    if (isPending()) {
+        if (key(m_pending.country, m_pending.city) == key(country, city)) {
+            // the wait is measured from the first attempt
+            ++m_pending.retries;
+            m_timeoutTimer->start();
+            return;
+        }
+
+        // abandoned in favour of another location
+        fail();
+    }
+
+    m_pending = { country, city, timestampMs, 0, false, m_status == NordVpnInfo::Status::Connected };
+    m_timeoutTimer->start();
+}
+
+void ConnectionStats::fail()
+{
+    if (!isPending()) {
+        return;
+    }
+
+    const Pending pending = m_pending;
+    m_pending = {};
+    m_timeoutTimer->stop();
+
+    if (pending.country.isEmpty()) {
+        LOG << "failed connection to an unknown location is not accounted";
+        return;
+    }
+
+    Record &rec = record(pending.country, pending.city);
+    ++rec.failures;
+    rec.retries += pending.retries;
+
+    m_store->scheduleSave();
+    emit updated(rec.country, rec.city);
+}
+
+void ConnectionStats::finish(const QString &country, const QString &city, qint64 durationMs)
+{
+    Record &rec = record(country, city);
+    ++rec.successes;
+    rec.retries += m_pending.retries;
+    rec.durationsMs.append(qMax<qint64>(0, durationMs));
+    if (rec.durationsMs.size() > MaxSamples) {
+        rec.durationsMs.remove(0, rec.durationsMs.size() - MaxSamples);
+    }
+
+    m_pending = {};
+    m_timeoutTimer->stop();
+
+    m_store->scheduleSave();
+    emit updated(rec.country, rec.city);
+}
+
+void ConnectionStats::onStateChanged(const NordVpnInfo &state)
+{
+    setState(state, QDateTime::currentMSecsSinceEpoch());
+}
+
+void ConnectionStats::setState(const NordVpnInfo &state, qint64 timestampMs)
+{
+    m_status = state.status();
+    if (!isPending()) {
+        return;
+    }
+
+    switch (state.status()) {
+    case NordVpnInfo::Status::Connecting: {
+        m_pending.connecting = true;
+        break;
+    }
+    case NordVpnInfo::Status::Connected: {
+        const bool sameCountry = key(m_pending.country, {}) == key(state.country(), {});
+        const bool sameCity = m_pending.city.isEmpty() || key({}, m_pending.city) == key({}, state.city());
+        const bool requested = !m_pending.country.isEmpty() && sameCountry && sameCity;
+        if (!m_pending.connecting && m_pending.fromConnected && !requested) {
+            // still the previous connection
+            break;
+        }
+
+        const QString &country = m_pending.country.isEmpty() ? state.country() : m_pending.country;
+        const QString &city = m_pending.city.isEmpty() && (m_pending.country.isEmpty() || sameCountry)
+                ? state.city()
+                : m_pending.city;
+        finish(country, city, timestampMs - m_pending.startedMs);
+        break;
+    }
+    case NordVpnInfo::Status::Disconnected: {
+        if (m_pending.connecting) {
+            fail();
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+/*static*/ qint64 ConnectionStats::percentile(QList<qint64> samples, double fraction)
+{
+    if (samples.isEmpty()) {
+        return -1;
+    }
+
+    // nearest-rank
+    const qsizetype rank = qBound<qsizetype>(1, qCeil(fraction * samples.size()), samples.size());
+    const auto nth = samples.begin() + (rank - 1);
+    std::nth_element(samples.begin(), nth, samples.end());
+    return *nth;
+}
+
+ConnectionStats::Summary ConnectionStats::summary(const QString &country, const QString &city) const
+{
+    Summary result;
+    QList<qint64> durations;
+
+    auto add = [&result, &durations](const Record &rec) {
+        result.successes += rec.successes;
+        result.failures += rec.failures;
+        result.retries += rec.retries;
+        durations.append(rec.durationsMs);
+    };
+
+    if (!city.isEmpty()) {
+        const auto it = m_records.constFind(key(country, city));
+        if (it != m_records.cend()) {
+            add(it.value());
+        }
+    } else {
+        const QString &countryKey = normalized(country).toCaseFolded();
+        for (const auto &rec : m_records) {
+            if (rec.country.toCaseFolded() == countryKey) {
+                add(rec);
+            }
+        }
+    }
+
+    if (!durations.isEmpty()) {
+        result.bestMs = *std::min_element(durations.cbegin(), durations.cend());
+        result.p50Ms = percentile(durations, 0.5);
+        result.p90Ms = percentile(durations, 0.9);
+    }
+
+    return result;
+}
+
+QString ConnectionStats::fastestCity(const QString &country) const
+{
+    const QString &countryKey = normalized(country).toCaseFolded();
+
+    QString fastest;
+    double bestScore(0.);
+    for (const auto &rec : m_records) {
+        if (rec.city.isEmpty() || !rec.successes || rec.country.toCaseFolded() != countryKey) {
+            continue;
+        }
+
+        // the typical wait, stretched by the attempts it takes to succeed
+        const Summary &stats = summary(rec.country, rec.city);
+        const double score = stats.p50Ms / stats.successRate();
+        if (fastest.isEmpty() || score < bestScore) {
+            fastest = rec.city;
+            bestScore = score;
+        }
+    }
+
+    return fastest;
+}
+
+int ConnectionStats::size() const
+{
+    return m_records.size();
+}
+
+void ConnectionStats::clear()
+{
+    m_records.clear();
+    m_pending = {};
+    m_timeoutTimer->stop();
+
+    m_store->scheduleSave();
+    emit updated({}, {});
+}
+
+void ConnectionStats::load()
+{
+    const QJsonArray &jArr = m_store->read();
+    for (const auto &jVal : jArr) {
+        const QJsonObject &jObj = jVal.toObject();
+        const QString &country = jObj.value(JsonConsts::Country).toString();
+        if (country.isEmpty()) {
+            continue;
+        }
+
+        Record &rec = record(country, jObj.value(JsonConsts::City).toString());
+        rec.successes = jObj.value(JsonConsts::Successes).toInt();
+        rec.failures = jObj.value(JsonConsts::Failures).toInt();
+        rec.retries = jObj.value(JsonConsts::Retries).toInt();
+        rec.durationsMs.clear();
+        const QJsonArray &jDurations = jObj.value(JsonConsts::Durations).toArray();
+        for (const auto &jDuration : jDurations) {
+            rec.durationsMs.append(jDuration.toInteger());
+        }
+        if (rec.durationsMs.size() > MaxSamples) {
+            rec.durationsMs.remove(0, rec.durationsMs.size() - MaxSamples);
+        }
+    }
+
+    LOG << "loaded" << m_records.size() << "locations from" << filePath();
+    emit updated({}, {});
+}
+
+void ConnectionStats::save()
+{
+    m_store->save();
+}
+
+QJsonArray ConnectionStats::toJson() const
+{
+    QJsonArray jArr;
+    for (const auto &rec : std::as_const(m_records)) {
+        QJsonArray jDurations;
+        for (const qint64 duration : rec.durationsMs) {
+            jDurations.append(duration);
+        }
+
+        jArr.append(QJsonObject {
+                { JsonConsts::Country, rec.country },
+                { JsonConsts::City, rec.city },
+                { JsonConsts::Successes, rec.successes },
+                { JsonConsts::Failures, rec.failures },
+                { JsonConsts::Retries, rec.retries },
+                { JsonConsts::Durations, jDurations },
+        });
+    }
+    return jArr;
+}
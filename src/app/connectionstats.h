@@ -0,0 +1,113 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include "app/nordvpninfo.h"
+
+#include <QHash>
+#include <QJsonArray>
+#include <QObject>
+
+class JsonFileStore;
+class QTimer;
+
+class ConnectionStats : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int MaxSamples = 64;
+    static constexpr int DefaultTimeoutMs = 60 * 1000;
+
+    struct Summary {
+        int successes = 0;
+        int failures = 0;
+        int retries = 0;
+        qint64 bestMs = -1;
+        qint64 p50Ms = -1;
+        qint64 p90Ms = -1;
+
+        int attempts() const { return successes + failures; }
+        bool isEmpty() const { return !attempts(); }
+        double successRate() const;
+        QString toString() const;
+    };
+
+    explicit ConnectionStats(const QString &filePath, QObject *parent = {});
+    ~ConnectionStats() override;
+
+    static QString defaultFilePath();
+    QString filePath() const;
+
+    void setTimeout(int ms);
+    int timeout() const;
+
+    // an empty location is resolved from the state reported once connected
+    void begin(const QString &country, const QString &city, qint64 timestampMs);
+    void fail();
+    bool isPending() const;
+
+    // an empty city aggregates all the cities of the country
+    Summary summary(const QString &country, const QString &city = {}) const;
+    QString fastestCity(const QString &country) const;
+    int size() const;
+
+    static qint64 percentile(QList<qint64> samples, double fraction);
+
+signals:
+    void updated(const QString &country, const QString &city);
+
+public slots:
+    void onStateChanged(const NordVpnInfo &state);
+    void setState(const NordVpnInfo &state, qint64 timestampMs);
+
+    void clear();
+    void load();
+    void save();
+
+private:
+    struct Record {
+        QString country;
+        QString city;
+        int successes = 0;
+        int failures = 0;
+        int retries = 0;
+        QList<qint64> durationsMs;
+    };
+
+    struct Pending {
+        QString country;
+        QString city;
+        qint64 startedMs = -1;
+        int retries = 0;
+        bool connecting = false;
+        bool fromConnected = false;
+    };
+
+    JsonFileStore *m_store;
+    QHash<QString, Record> m_records;
+    Pending m_pending;
+    NordVpnInfo::Status m_status;
+    QTimer *m_timeoutTimer;
+
+    static QString normalized(const QString &name);
+    static QString key(const QString &country, const QString &city);
+
+    Record &record(const QString &country, const QString &city);
+    void finish(const QString &country, const QString &city, qint64 durationMs);
+    QJsonArray toJson() const;
+};
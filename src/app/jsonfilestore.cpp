@@ -0,0 +1,141 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "jsonfilestore.h"
+
+#include "app/common.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+
+namespace JsonConsts {
+static const QLatin1String Version { "version" };
+static const QLatin1String Entries { "entries" };
+};
+
+JsonFileStore::JsonFileStore(const QString &filePath, int version, QObject *parent)
+    : QObject(parent)
+    , m_filePath(filePath)
+    , m_version(version)
+    , m_saveTimer(new QTimer(this))
+{
+    m_saveTimer->setSingleShot(true);
+    connect(m_saveTimer, &QTimer::timeout, this, &JsonFileStore::save);
+}
+
+QString JsonFileStore::filePath() const
+{
+    return m_filePath;
+}
+
+int JsonFileStore::version() const
+{
+    return m_version;
+}
+
+void JsonFileStore::setWriter(const Writer &writer)
+{
+    m_writer = writer;
+}
+
+QJsonArray JsonFileStore::read() const
+{
+    QFile in(m_filePath);
+    if (m_filePath.isEmpty() || !in.exists()) {
+        return {};
+    }
+
+    if (!in.open(QFile::ReadOnly | QFile::Text)) {
+        WRN << "failed opening file" << m_filePath << in.errorString();
+        return {};
+    }
+
+    QJsonParseError err;
+    const QJsonDocument &jDoc = QJsonDocument::fromJson(in.readAll(), &err);
+    if (err.error != QJsonParseError::NoError) {
+        WRN << "error parsing document:" << err.errorString();
+        return {};
+    }
+
+    const QJsonObject &jRoot = jDoc.object();
+    if (jRoot.value(JsonConsts::Version).toInt() != m_version) {
+        WRN << "unsupported version, ignored:" << m_filePath;
+        return {};
+    }
+
+    return jRoot.value(JsonConsts::Entries).toArray();
+}
+
+bool JsonFileStore::isSavePending() const
+{
+    return m_saveTimer->isActive();
+}
+
+void JsonFileStore::scheduleSave()
+{
+    if (m_filePath.isEmpty()) {
+        return;
+    }
+
+    if (!m_saveTimer->isActive()) {
+        m_pendingSince.start();
+    }
+
+    const qint64 untilMax = MaxSaveDelayMs - m_pendingSince.elapsed();
+    m_saveTimer->start(static_cast<int>(qBound<qint64>(0, untilMax, utils::oneSecondMs())));
+}
+
+void JsonFileStore::flush()
+{
+    if (m_saveTimer->isActive()) {
+        save();
+    }
+}
+
+void JsonFileStore::discard()
+{
+    m_saveTimer->stop();
+
+    if (!m_filePath.isEmpty() && QFile::exists(m_filePath) && !QFile::remove(m_filePath)) {
+        WRN << "failed removing" << m_filePath;
+    }
+}
+
+void JsonFileStore::save()
+{
+    m_saveTimer->stop();
+    if (m_filePath.isEmpty() || !m_writer) {
+        return;
+    }
+
+    QFile out(utils::ensureDirExists(m_filePath));
+    if (!out.open(QFile::WriteOnly | QFile::Text | QFile::Truncate)) {
+        WRN << "failed opening file" << m_filePath << out.errorString();
+        return;
+    }
+
+    const QJsonDocument jDoc(QJsonObject {
+            { JsonConsts::Version, m_version },
+            { JsonConsts::Entries, m_writer() },
+    });
+
+    if (-1 == out.write(jDoc.toJson(QJsonDocument::Compact))) {
+        WRN << "error during file write:" << out.errorString();
+    }
+}
@@ -0,0 +1,63 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QObject>
+#include <functional>
+
+class QTimer;
+
+// A versioned JSON file holding an array of entries, the owner provides the (de)serialization.
+// Saving is debounced: written a second after the last change, or MaxSaveDelayMs after the first
+// pending one if the changes keep coming.
+// An empty file path keeps everything in memory.
+class JsonFileStore : public QObject
+{
+    Q_OBJECT
+public:
+    using Writer = std::function<QJsonArray()>;
+
+    static constexpr int MaxSaveDelayMs = 10000;
+
+    JsonFileStore(const QString &filePath, int version, QObject *parent = {});
+
+    QString filePath() const;
+    int version() const;
+
+    void setWriter(const Writer &writer);
+
+    // the stored entries, empty if the file is missing, broken or of another version
+    QJsonArray read() const;
+
+    bool isSavePending() const;
+    void scheduleSave();
+    void flush();
+    void discard();
+
+public slots:
+    void save();
+
+private:
+    const QString m_filePath;
+    const int m_version;
+    Writer m_writer;
+    QTimer *m_saveTimer;
+    QElapsedTimer m_pendingSince;
+};
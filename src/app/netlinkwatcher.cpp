@@ -0,0 +1,262 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "netlinkwatcher.h"
+
+#include "app/common.h"
+
+#include <QSocketNotifier>
+#include <QTimer>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <cstring>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// the interfaces the NordVPN daemon creates for NordLynx and OpenVPN; generic tun*/wg* belong to other VPNs
+/*static*/ const QStringList NetlinkWatcher::DefaultInterfacePrefixes { QStringLiteral("nordlynx"),
+                                                                        QStringLiteral("nordtun") };
+/*static*/ const int NetlinkWatcher::DefaultDebounceMs = 50;
+
+NetlinkWatcher::NetlinkWatcher(QObject *parent)
+    : QObject(parent)
+    , m_fd(-1)
+    , m_notifier(nullptr)
+    , m_debounce(new QTimer(this))
+    , m_prefixes(DefaultInterfacePrefixes)
+{
+    m_debounce->setSingleShot(true);
+    m_debounce->setInterval(DefaultDebounceMs);
+    connect(m_debounce, &QTimer::timeout, this, &NetlinkWatcher::changed);
+}
+
+NetlinkWatcher::~NetlinkWatcher()
+{
+    stop();
+}
+
+/*static*/ bool NetlinkWatcher::isSupported()
+{
+#ifdef Q_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool NetlinkWatcher::start()
+{
+    if (isRunning()) {
+        return true;
+    }
+
+#ifdef Q_OS_LINUX
+    const int fd = ::socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0) {
+        WRN << "Failed to open netlink socket:" << std::strerror(errno);
+        return false;
+    }
+
+    sockaddr_nl address {};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+        WRN << "Failed to bind netlink socket:" << std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_notifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &NetlinkWatcher::onActivated);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void NetlinkWatcher::stop()
+{
+    if (m_notifier) {
+        m_notifier->setEnabled(false);
+        delete m_notifier;
+        m_notifier = nullptr;
+    }
+
+#ifdef Q_OS_LINUX
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+#endif
+    m_fd = -1;
+
+    m_debounce->stop();
+    m_names.clear();
+}
+
+bool NetlinkWatcher::isRunning() const
+{
+    return m_fd >= 0;
+}
+
+QStringList NetlinkWatcher::interfacePrefixes() const
+{
+    return m_prefixes;
+}
+
+void NetlinkWatcher::setInterfacePrefixes(const QStringList &prefixes)
+{
+    m_prefixes = prefixes;
+}
+
+int NetlinkWatcher::debounce() const
+{
+    return m_debounce->interval();
+}
+
+void NetlinkWatcher::setDebounce(int msecs)
+{
+    m_debounce->setInterval(qMax(0, msecs));
+}
+
+void NetlinkWatcher::onActivated()
+{
+#ifdef Q_OS_LINUX
+    QByteArray buffer(16 * 1024, Qt::Uninitialized);
+    while (true) {
+        const ssize_t received = ::recv(m_fd, buffer.data(), buffer.size(), 0);
+        if (received < 0) {
+            if (errno == ENOBUFS) {
+                // the kernel dropped events, so something has changed anyway
+                m_debounce->start();
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                WRN << "Netlink read failed:" << std::strerror(errno);
+            }
+            break;
+        }
+        if (received == 0) {
+            break;
+        }
+
+        processMessages(QByteArray::fromRawData(buffer.constData(), received));
+    }
+#endif
+}
+
+int NetlinkWatcher::processMessages(const QByteArray &buffer)
+{
+    int relevant(0);
+
+#ifdef Q_OS_LINUX
+    auto attribute = [](const rtattr *attr, int len, unsigned short type) -> QString {
+        for (; RTA_OK(attr, len); attr = RTA_NEXT(attr, len)) {
+            if (attr->rta_type == type) {
+                const char *data = static_cast<const char *>(RTA_DATA(attr));
+                return QString::fromLatin1(data, qstrnlen(data, RTA_PAYLOAD(attr)));
+            }
+        }
+        return {};
+    };
+
+    int len = buffer.size();
+    for (auto *header = reinterpret_cast<const nlmsghdr *>(buffer.constData()); NLMSG_OK(header, len);
+         header = NLMSG_NEXT(header, len)) {
+        QString name;
+
+        switch (header->nlmsg_type) {
+        case RTM_NEWLINK:
+        case RTM_DELLINK: {
+            if (header->nlmsg_len < NLMSG_LENGTH(sizeof(ifinfomsg))) {
+                continue;
+            }
+            const auto *info = static_cast<const ifinfomsg *>(NLMSG_DATA(header));
+            name = attribute(IFLA_RTA(info), IFLA_PAYLOAD(header), IFLA_IFNAME);
+            if (name.isEmpty()) {
+                name = m_names.value(info->ifi_index);
+            }
+
+            if (header->nlmsg_type == RTM_DELLINK) {
+                m_names.remove(info->ifi_index);
+            } else if (!name.isEmpty()) {
+                m_names.insert(info->ifi_index, name);
+            }
+            break;
+        }
+        case RTM_NEWADDR:
+        case RTM_DELADDR: {
+            if (header->nlmsg_len < NLMSG_LENGTH(sizeof(ifaddrmsg))) {
+                continue;
+            }
+            const auto *info = static_cast<const ifaddrmsg *>(NLMSG_DATA(header));
+            name = attribute(IFA_RTA(info), IFA_PAYLOAD(header), IFA_LABEL);
+            if (name.isEmpty()) {
+                name = m_names.value(static_cast<int>(info->ifa_index));
+            }
+            if (name.isEmpty()) {
+                char ifName[IF_NAMESIZE] = {};
+                if (::if_indextoname(info->ifa_index, ifName)) {
+                    name = QString::fromLatin1(ifName);
+                }
+            }
+            break;
+        }
+        default:
+            continue;
+        }
+
+        if (isRelevant(name)) {
+            ++relevant;
+            notify(name);
+        }
+    }
+#else
+    Q_UNUSED(buffer);
+#endif
+
+    return relevant;
+}
+
+bool NetlinkWatcher::isRelevant(const QString &name) const
+{
+    if (name.isEmpty()) {
+        return false;
+    }
+
+    for (const QString &prefix : m_prefixes) {
+        if (name.startsWith(prefix)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void NetlinkWatcher::notify(const QString &name)
+{
+    emit interfaceChanged(name);
+
+    if (!m_debounce->isActive()) {
+        m_debounce->start();
+    }
+}
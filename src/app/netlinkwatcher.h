@@ -0,0 +1,68 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+
+class QSocketNotifier;
+class QTimer;
+
+class NetlinkWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    static const QStringList DefaultInterfacePrefixes;
+    static const int DefaultDebounceMs;
+
+    explicit NetlinkWatcher(QObject *parent = {});
+    ~NetlinkWatcher() override;
+
+    static bool isSupported();
+
+    bool start();
+    void stop();
+    bool isRunning() const;
+
+    QStringList interfacePrefixes() const;
+    void setInterfacePrefixes(const QStringList &prefixes);
+
+    int debounce() const;
+    void setDebounce(int msecs);
+
+    int processMessages(const QByteArray &buffer);
+
+signals:
+    void interfaceChanged(const QString &name);
+    void changed();
+
+private slots:
+    void onActivated();
+
+private:
+    int m_fd;
+    QSocketNotifier *m_notifier;
+    QTimer *m_debounce;
+    QStringList m_prefixes;
+    QHash<int, QString> m_names;
+
+    bool isRelevant(const QString &name) const;
+    void notify(const QString &name);
+};
@@ -19,7 +19,15 @@
 
 #include "common.h"
 
+#include <QHash>
+#include <QHashFunctions>
+#include <QList>
+#include <QLocale>
 #include <QMetaEnum>
+#include <QMutex>
+#include <algorithm>
+#include <array>
+#include <atomic>
 
 /*static*/ int NordVpnInfo::MetaIdClass = -1;
 /*static*/ int NordVpnInfo::MetaIdEnum = -1;
@@ -39,14 +47,18 @@ NordVpnInfo::NordVpnInfo()
 void NordVpnInfo::clear()
 {
     m_status = Status::Unknown;
-    m_server.clear();
-    m_country.clear();
-    m_city.clear();
-    m_ip.clear();
-    m_technology.clear();
-    m_protocol.clear();
-    m_traffic.clear();
-    m_uptime.clear();
+    m_trafficSource = TrafficSource::None;
+    m_server = 0;
+    m_country = 0;
+    m_city = 0;
+    m_ip = 0;
+    m_technology = 0;
+    m_protocol = 0;
+    m_rxRate = 0.f;
+    m_txRate = 0.f;
+    m_uptime = Uptime(-1);
+    m_rxBytes = 0;
+    m_txBytes = 0;
 }
 
 NordVpnInfo::Status NordVpnInfo::status() const
@@ -63,9 +75,7 @@ void NordVpnInfo::setStatus(NordVpnInfo::Status status)
 
 bool NordVpnInfo::operator==(const NordVpnInfo &other) const
 {
-    return m_status == other.m_status && m_server == other.m_server && m_country == other.m_country
-            && m_city == other.m_city && m_ip == other.m_ip && m_technology == other.m_technology
-            && m_protocol == other.m_protocol && m_traffic == other.m_traffic && m_uptime == other.m_uptime;
+    return sameStructure(other) && sameTelemetry(other);
 }
 
 bool NordVpnInfo::operator!=(const NordVpnInfo &other) const
@@ -73,64 +83,392 @@ bool NordVpnInfo::operator!=(const NordVpnInfo &other) const
     return !this->operator==(other);
 }
 
-/*static*/ NordVpnInfo NordVpnInfo::fromString(const QString &text)
+bool NordVpnInfo::sameStructure(const NordVpnInfo &other) const
+{
+    return m_status == other.m_status && m_server == other.m_server && m_country == other.m_country
+            && m_city == other.m_city && m_ip == other.m_ip && m_technology == other.m_technology
+            && m_protocol == other.m_protocol;
+}
+
+bool NordVpnInfo::sameTelemetry(const NordVpnInfo &other) const
 {
-    LOG << text;
-    if (text.contains("connecting", Qt::CaseInsensitive)) {
-        int dbg = 0;
+    return m_uptime == other.m_uptime && m_trafficSource == other.m_trafficSource && m_rxBytes == other.m_rxBytes
+            && m_txBytes == other.m_txBytes && m_rxRate == other.m_rxRate && m_txRate == other.m_txRate;
+}
+
+namespace {
+enum class Field
+{
+    Status,
+    Server,
+    Country,
+    City,
+    Ip,
+    Technology,
+    Protocol,
+    Traffic,
+    Uptime,
+};
+
+struct FieldKey {
+    QStringView key;
+    Field field;
+};
+
+constexpr std::array<FieldKey, 9> FieldKeys { {
+        { u"Status", Field::Status },
+        { u"Current server", Field::Server },
+        { u"Country", Field::Country },
+        { u"City", Field::City },
+        { u"Your new IP", Field::Ip },
+        { u"Current technology", Field::Technology },
+        { u"Current protocol", Field::Protocol },
+        { u"Transfer", Field::Traffic },
+        { u"Uptime", Field::Uptime },
+} };
+
+struct StatusKey {
+    QStringView key;
+    NordVpnInfo::Status status;
+};
+
+constexpr std::array<StatusKey, 5> StatusKeys { {
+        { u"Unknown", NordVpnInfo::Status::Unknown },
+        { u"Disconnected", NordVpnInfo::Status::Disconnected },
+        { u"Connecting", NordVpnInfo::Status::Connecting },
+        { u"Connected", NordVpnInfo::Status::Connected },
+        { u"Disconnecting", NordVpnInfo::Status::Disconnecting },
+} };
+
+// true for runs of whitespace or tabs inside, which the CLI doesn't normally print
+bool needsSimplify(QStringView from)
+{
+    for (qsizetype i = 0; i < from.size(); ++i) {
+        const QChar c = from.at(i);
+        if (c.isSpace() && (c != QChar(' ') || (i + 1 < from.size() && from.at(i + 1).isSpace()))) {
+            return true;
+        }
     }
-    NordVpnInfo updatedState;
-    if (text.isEmpty()) {
-        return updatedState;
+
+    return false;
+}
+
+// Country, city, technology and protocol names come from the NordVPN catalogue, so they are kept for good.
+// The table has a fixed capacity and is read without locking: a known name costs a hash and a compare,
+// only a new one takes the mutex and allocates.
+class NamePool
+{
+public:
+    static constexpr quint32 Capacity = 2048;
+
+    static NamePool &instance()
+    {
+        static NamePool pool;
+        return pool;
     }
 
-    const QStringList &pairs = text.split('\n', Qt::SkipEmptyParts);
-    for (const QString &line : pairs) {
-        const QStringList &pair = line.split(':', Qt::SkipEmptyParts);
-        if (pair.size() != 2) {
-            WRN << "Unexpected format:" << line;
-            continue;
+    quint32 intern(QStringView value)
+    {
+        if (value.isEmpty()) {
+            return 0;
+        }
+
+        const size_t hash = qHash(value);
+        size_t bucket(0);
+        if (const quint32 id = find(value, hash, &bucket)) {
+            return id;
+        }
+
+        QMutexLocker locker(&m_mutex);
+        if (const quint32 id = find(value, hash, &bucket)) {
+            return id;
+        }
+
+        const quint32 size = m_size.load(std::memory_order_relaxed);
+        if (size == Capacity) {
+            WRN << "names pool is full, dropped:" << value;
+            return 0;
+        }
+
+        m_strings[size] = value.toString();
+        m_size.store(size + 1, std::memory_order_release);
+        m_buckets[bucket].store(size + 1, std::memory_order_release);
+        return size + 1;
+    }
+
+    QString value(quint32 id) const
+    {
+        return id && id <= m_size.load(std::memory_order_acquire) ? m_strings[id - 1] : QString();
+    }
+
+    quint32 size() const { return m_size.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t BucketsCount = Capacity * 2;
+
+    std::array<QString, Capacity> m_strings;
+    std::array<std::atomic<quint32>, BucketsCount> m_buckets {};
+    std::atomic<quint32> m_size { 0 };
+    QMutex m_mutex;
+
+    NamePool() = default;
+
+    // linear probing, the table is never more than half full
+    quint32 find(QStringView value, size_t hash, size_t *bucket) const
+    {
+        for (size_t i = hash % BucketsCount;; i = (i + 1) % BucketsCount) {
+            const quint32 id = m_buckets[i].load(std::memory_order_acquire);
+            if (!id || m_strings[id - 1] == value) {
+                *bucket = i;
+                return id;
+            }
+        }
+    }
+};
+
+// Servers and addresses change with every connection, so only the most recent ones are kept.
+// Ids grow monotonically and an evicted one reads as an empty string.
+class RecentPool
+{
+public:
+    static constexpr quint32 Capacity = 256;
+
+    static RecentPool &instance()
+    {
+        static RecentPool pool;
+        return pool;
+    }
+
+    quint32 intern(QStringView value)
+    {
+        if (value.isEmpty()) {
+            return 0;
+        }
+
+        QMutexLocker locker(&m_mutex);
+        for (const auto &slot : m_slots) {
+            if (slot.id && slot.value == value) {
+                return slot.id;
+            }
         }
 
-        const QString &name = pair.first().simplified();
-        const QString &value = pair.last().simplified();
-
-        if (name == QStringLiteral("Status")) {
-            updatedState.m_status = textToStatus(value);
-        } else if (name == QStringLiteral("Current server")) {
-            updatedState.m_server = value;
-        } else if (name == QStringLiteral("Country")) {
-            updatedState.m_country = value;
-        } else if (name == QStringLiteral("City")) {
-            updatedState.m_city = value;
-        } else if (name == QStringLiteral("Your new IP")) {
-            updatedState.m_ip = value;
-        } else if (name == QStringLiteral("Current technology")) {
-            updatedState.m_technology = value;
-        } else if (name == QStringLiteral("Current protocol")) {
-            updatedState.m_protocol = value;
-        } else if (name == QStringLiteral("Transfer")) {
-            updatedState.m_traffic = value;
-            updatedState.m_traffic.replace(QStringLiteral("received"), QStringLiteral("↓"));
-            updatedState.m_traffic.replace(QStringLiteral("sent"), QStringLiteral("↑"));
-        } else if (name == QStringLiteral("Uptime")) {
-            updatedState.m_uptime = parseUptime(value.simplified());
+        Slot &slot = m_slots[m_lastId % Capacity];
+        slot.id = ++m_lastId;
+        slot.value = value.toString();
+        return slot.id;
+    }
+
+    QString value(quint32 id) const
+    {
+        if (!id) {
+            return {};
         }
+
+        QMutexLocker locker(&m_mutex);
+        const Slot &slot = m_slots[(id - 1) % Capacity];
+        return slot.id == id ? slot.value : QString();
+    }
+
+    quint32 size() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return qMin(m_lastId, Capacity);
     }
 
+private:
+    struct Slot {
+        quint32 id = 0;
+        QString value;
+    };
+
+    mutable QMutex m_mutex;
+    std::array<Slot, Capacity> m_slots;
+    quint32 m_lastId = 0;
+
+    RecentPool() = default;
+};
+
+struct DataUnit {
+    QStringView name;
+    double multiplier;
+};
+
+constexpr std::array<DataUnit, 11> DataUnits { {
+        { u"B", 1. },
+        { u"KiB", 1024. },
+        { u"MiB", 1024. * 1024. },
+        { u"GiB", 1024. * 1024. * 1024. },
+        { u"TiB", 1024. * 1024. * 1024. * 1024. },
+        { u"kB", 1000. },
+        { u"KB", 1000. },
+        { u"MB", 1000. * 1000. },
+        { u"GB", 1000. * 1000. * 1000. },
+        { u"TB", 1000. * 1000. * 1000. * 1000. },
+        { u"bytes", 1. },
+} };
+
+struct UptimeUnit {
+    QStringView prefix;
+    qint64 seconds;
+};
+
+constexpr std::array<UptimeUnit, 5> UptimeUnits { {
+        { u"year", 365 * 24 * 60 * 60 },
+        { u"day", 24 * 60 * 60 },
+        { u"hour", 60 * 60 },
+        { u"minute", 60 },
+        { u"second", 1 },
+} };
+
+const FieldKey *fieldFor(QStringView key)
+{
+    const auto it = std::find_if(FieldKeys.cbegin(), FieldKeys.cend(),
+                                 [key](const FieldKey &fieldKey) { return fieldKey.key == key; });
+    return it == FieldKeys.cend() ? nullptr : &*it;
+}
+
+bool isTelemetry(const FieldKey *fieldKey)
+{
+    return fieldKey && (fieldKey->field == Field::Traffic || fieldKey->field == Field::Uptime);
+}
+
+template<typename Handler>
+void forEachField(QStringView text, Handler &&handler)
+{
+    for (const QStringView line : text.tokenize(u'\n', Qt::SkipEmptyParts)) {
+        const qsizetype colon = line.indexOf(u':');
+        handler(line, colon > 0 ? line.first(colon).trimmed() : QStringView(),
+                colon > 0 ? line.sliced(colon + 1).trimmed() : QStringView());
+    }
+}
+} // namespace
+
+/*static*/ NordVpnInfo NordVpnInfo::fromString(const QString &text)
+{
+    return fromString(QStringView(text));
+}
+
+/*static*/ NordVpnInfo NordVpnInfo::fromString(QStringView text)
+{
+    NordVpnInfo updatedState;
+
+    forEachField(text, [&updatedState](QStringView line, QStringView key, QStringView value) {
+        if (key.isEmpty()) {
+            if (!line.trimmed().isEmpty()) {
+                WRN << "Unexpected format:" << line;
+            }
+            return;
+        }
+
+        updatedState.setField(key, value);
+    });
+
     return updatedState;
 }
 
+/*static*/ size_t NordVpnInfo::structuralFingerprint(QStringView text)
+{
+    size_t seed(0);
+    forEachField(text, [&seed](QStringView line, QStringView key, QStringView /*value*/) {
+        if (!isTelemetry(fieldFor(key))) {
+            seed = qHashMulti(seed, line.trimmed());
+        }
+    });
+
+    return seed;
+}
+
+void NordVpnInfo::updateTelemetry(QStringView text)
+{
+    m_uptime = Uptime(-1);
+    if (m_trafficSource == TrafficSource::Cli) {
+        m_trafficSource = TrafficSource::None;
+        m_rxBytes = 0;
+        m_txBytes = 0;
+    }
+
+    forEachField(text, [this](QStringView /*line*/, QStringView key, QStringView value) {
+        if (isTelemetry(fieldFor(key))) {
+            setField(key, value);
+        }
+    });
+}
+
+void NordVpnInfo::setField(QStringView key, QStringView value)
+{
+    const FieldKey *it = fieldFor(key);
+    if (!it || value.isEmpty()) {
+        return;
+    }
+
+    QString simplified;
+    if (needsSimplify(value)) {
+        simplified = value.toString().simplified();
+        value = simplified;
+    }
+
+    // the same value is seen on every poll, the pools are only asked when it differs
+    auto internName = [value](quint32 &id) {
+        if (!id || NamePool::instance().value(id) != value) {
+            id = NamePool::instance().intern(value);
+        }
+    };
+    auto internRecent = [value](quint32 &id) {
+        if (!id || RecentPool::instance().value(id) != value) {
+            id = RecentPool::instance().intern(value);
+        }
+    };
+
+    switch (it->field) {
+    case Field::Status:
+        m_status = textToStatus(value);
+        break;
+    case Field::Server:
+        internRecent(m_server);
+        break;
+    case Field::Country:
+        internName(m_country);
+        break;
+    case Field::City:
+        internName(m_city);
+        break;
+    case Field::Ip:
+        internRecent(m_ip);
+        break;
+    case Field::Technology:
+        internName(m_technology);
+        break;
+    case Field::Protocol:
+        internName(m_protocol);
+        break;
+    case Field::Traffic: {
+        quint64 rx(0), tx(0);
+        if (m_trafficSource != TrafficSource::Counters && parseTraffic(value, rx, tx)) {
+            setTraffic(rx, tx);
+        }
+        break;
+    }
+    case Field::Uptime:
+        m_uptime = parseUptimeDuration(value);
+        break;
+    }
+}
+
 /*static*/ NordVpnInfo::Status NordVpnInfo::textToStatus(const QString &from)
 {
-    if (from.isEmpty()) {
-        return NordVpnInfo::Status::Unknown;
+    return textToStatus(QStringView(from));
+}
+
+/*static*/ NordVpnInfo::Status NordVpnInfo::textToStatus(QStringView from)
+{
+    from = from.trimmed();
+    for (const auto &statusKey : StatusKeys) {
+        if (statusKey.key == from) {
+            return statusKey.status;
+        }
     }
 
-    const QMetaEnum me = QMetaEnum::fromType<NordVpnInfo::Status>();
-    bool found(false);
-    const int enumVal = me.keyToValue(qPrintable(from), &found);
-    return (found ? static_cast<NordVpnInfo::Status>(enumVal) : NordVpnInfo::Status::Unknown);
+    return NordVpnInfo::Status::Unknown;
 }
 
 /*static*/ QString NordVpnInfo::statusToText(NordVpnInfo::Status from)
@@ -139,7 +477,53 @@ bool NordVpnInfo::operator!=(const NordVpnInfo &other) const
     return me.valueToKey(static_cast<int>(from));
 }
 
+/*static*/ bool NordVpnInfo::parseTraffic(QStringView from, quint64 &rxBytes, quint64 &txBytes)
+{
+    // "0.97 MiB received, 452.22 KiB sent"
+    bool found(false);
+    bool hasAmount(false);
+    double amount(0.);
+    double multiplier(1.);
+
+    for (QStringView word : from.tokenize(u' ', Qt::SkipEmptyParts)) {
+        while (word.endsWith(u',')) {
+            word.chop(1);
+        }
+
+        if (hasAmount && (word.startsWith(u"received") || word.startsWith(u"sent"))) {
+            (word.startsWith(u"received") ? rxBytes : txBytes) = static_cast<quint64>(qRound64(amount * multiplier));
+            found = true;
+            hasAmount = false;
+            continue;
+        }
+
+        bool converted(false);
+        const double number = word.toDouble(&converted);
+        if (converted) {
+            amount = number;
+            multiplier = 1.;
+            hasAmount = true;
+            continue;
+        }
+
+        if (hasAmount) {
+            const auto unit = std::find_if(DataUnits.cbegin(), DataUnits.cend(),
+                                           [word](const DataUnit &dataUnit) { return dataUnit.name == word; });
+            if (unit != DataUnits.cend()) {
+                multiplier = unit->multiplier;
+            }
+        }
+    }
+
+    return found;
+}
+
 /*static*/ QString NordVpnInfo::parseUptime(const QString &from)
+{
+    return parseUptime(QStringView(from));
+}
+
+/*static*/ QString NordVpnInfo::parseUptime(QStringView from)
 {
     QString result;
 
@@ -147,77 +531,285 @@ bool NordVpnInfo::operator!=(const NordVpnInfo &other) const
         return result;
     }
 
-    auto add = [&result](int value, int width = 2) {
-        if (!result.isEmpty()) {
+    result.reserve(16);
+    int fields(0);
+    auto add = [&result, &fields](int value, int width) {
+        if (fields++) {
             result.append(QChar(':'));
         }
-        result += QString("%1").arg(value, width, 10, QChar('0'));
+        const QString number = QString::number(value);
+        for (qsizetype i = number.size(); i < width; ++i) {
+            result.append(QChar('0'));
+        }
+        result.append(number);
     };
 
-    const QStringList &parts = from.split(QChar(' '), Qt::SkipEmptyParts);
-    for (int i = 0; i <= parts.size() - 2; ++i) {
-        bool converted(false);
-        const int value = parts.at(i).toInt(&converted);
-        if (!converted) {
+    bool hasValue(false);
+    int value(0);
+    for (const QStringView part : from.tokenize(u' ', Qt::SkipEmptyParts)) {
+        if (!hasValue) {
+            bool converted(false);
+            value = part.toInt(&converted);
+            hasValue = converted;
             continue;
         }
 
-        const QString &units = parts.at(++i);
-
-        if (units.startsWith(QStringLiteral("day"))) {
-            add(value, 3);
-        } else {
-            add(value, 2);
-        }
+        add(value, part.startsWith(u"day") ? 3 : 2);
+        hasValue = false;
     }
 
-    if (result.count(QChar(':')) <= 2) {
+    if (fields <= 3) {
         result.prepend(QStringLiteral("00:"));
     }
 
     return result;
 }
 
+/*static*/ NordVpnInfo::Uptime NordVpnInfo::parseUptimeDuration(QStringView from)
+{
+    if (from.trimmed().isEmpty()) {
+        return Uptime(-1);
+    }
+
+    qint64 seconds(0);
+    bool hasValue(false);
+    qint64 value(0);
+    for (const QStringView part : from.tokenize(u' ', Qt::SkipEmptyParts)) {
+        if (!hasValue) {
+            bool converted(false);
+            value = part.toLongLong(&converted);
+            hasValue = converted;
+            continue;
+        }
+
+        const auto unit =
+                std::find_if(UptimeUnits.cbegin(), UptimeUnits.cend(),
+                             [part](const UptimeUnit &uptimeUnit) { return part.startsWith(uptimeUnit.prefix); });
+        if (unit != UptimeUnits.cend()) {
+            seconds += value * unit->seconds;
+        }
+        hasValue = false;
+    }
+
+    return Uptime(seconds);
+}
+
+/*static*/ QString NordVpnInfo::formatUptime(Uptime uptime)
+{
+    if (uptime.count() < 0) {
+        return {};
+    }
+
+    const qint64 total = uptime.count();
+    const qint64 days = total / (24 * 60 * 60);
+    const qint64 hours = (total / (60 * 60)) % 24;
+    const qint64 minutes = (total / 60) % 60;
+    const qint64 seconds = total % 60;
+
+    const QChar zero('0');
+    return QStringLiteral("%1:%2:%3:%4")
+            .arg(days, days ? 3 : 2, 10, zero)
+            .arg(hours, 2, 10, zero)
+            .arg(minutes, 2, 10, zero)
+            .arg(seconds, 2, 10, zero);
+}
+
 QString NordVpnInfo::toString() const
 {
-    QString text;
-    text.append(QObject::tr("<b>%1</b>").arg(statusToText(m_status)));
+    return composeHtml(structureToString(), telemetryToText());
+}
 
-    if (m_status != NordVpnInfo::Status::Connected && m_status != NordVpnInfo::Status::Connecting) {
-        return text;
+/*static*/ QString NordVpnInfo::composeHtml(const QString &structureHtml, const QString &telemetryText)
+{
+    if (telemetryText.isEmpty()) {
+        return structureHtml;
     }
 
-    auto add = [&text](const QString &str, const QString &delim = QStringLiteral("<br>")) {
-        if (!str.isEmpty()) {
-            if (!text.isEmpty()) {
-                text.append(delim);
-            }
-            text.append(str);
+    QString telemetry = telemetryText.toHtmlEscaped();
+    telemetry.replace(QLatin1Char('\n'), QLatin1String("<br>"));
+    return QStringLiteral("%1<br>%2").arg(structureHtml, telemetry);
+}
+
+QString NordVpnInfo::structureToString() const
+{
+    QString text = QObject::tr("<b>%1</b>").arg(statusToText(m_status));
+    if (isTunnelStatus(m_status)) {
+        appendStructure(text);
+    }
+    return text;
+}
+
+QString NordVpnInfo::telemetryToText() const
+{
+    QString text;
+    if (isTunnelStatus(m_status)) {
+        if (hasUptime()) {
+            appendField(text, formatUptime(m_uptime), QStringLiteral("\n"));
         }
-        return text;
-    };
+        appendField(text, traffic(), QStringLiteral("\n"));
+    }
+    return text;
+}
+
+/*static*/ bool NordVpnInfo::isTunnelStatus(Status status)
+{
+    return status == NordVpnInfo::Status::Connected || status == NordVpnInfo::Status::Connecting;
+}
 
-    if (!m_uptime.isEmpty()) {
-        text = add(m_uptime, QStringLiteral(" "));
+/*static*/ void NordVpnInfo::appendField(QString &text, const QString &field, const QString &delim)
+{
+    if (!field.isEmpty()) {
+        if (!text.isEmpty()) {
+            text.append(delim);
+        }
+        text.append(field);
     }
+}
 
-    text = add(m_server);
-    text = add(m_city, QStringLiteral(" — "));
-    text = add(m_country, QStringLiteral(", "));
-    text = add(m_ip);
-    text = add(m_technology);
-    text = add(m_protocol, QStringLiteral(", "));
-    text = add(m_traffic);
+void NordVpnInfo::appendStructure(QString &text) const
+{
+    const QString &lineBreak = QStringLiteral("<br>");
+    appendField(text, server(), lineBreak);
+    appendField(text, city(), QStringLiteral(" — "));
+    appendField(text, country(), QStringLiteral(", "));
+    appendField(text, ip(), lineBreak);
+    appendField(text, technology(), lineBreak);
+    appendField(text, protocol(), QStringLiteral(", "));
+}
 
-    return text;
+/*static*/ qsizetype NordVpnInfo::internedCount()
+{
+    return NamePool::instance().size() + RecentPool::instance().size();
+}
+
+/*static*/ QString NordVpnInfo::serverName(quint32 serverId)
+{
+    return RecentPool::instance().value(serverId);
+}
+
+QString NordVpnInfo::server() const
+{
+    return RecentPool::instance().value(m_server);
+}
+
+quint32 NordVpnInfo::serverId() const
+{
+    return m_server;
 }
 
 QString NordVpnInfo::country() const
 {
-    return m_country;
+    return NamePool::instance().value(m_country);
 }
 
 QString NordVpnInfo::city() const
 {
-    return m_city;
+    return NamePool::instance().value(m_city);
+}
+
+QString NordVpnInfo::ip() const
+{
+    return RecentPool::instance().value(m_ip);
+}
+
+QString NordVpnInfo::technology() const
+{
+    return NamePool::instance().value(m_technology);
+}
+
+QString NordVpnInfo::protocol() const
+{
+    return NamePool::instance().value(m_protocol);
+}
+
+bool NordVpnInfo::hasUptime() const
+{
+    return m_uptime.count() >= 0;
+}
+
+NordVpnInfo::Uptime NordVpnInfo::uptime() const
+{
+    return m_uptime;
+}
+
+QString NordVpnInfo::traffic() const
+{
+    if (m_trafficSource == TrafficSource::None) {
+        return {};
+    }
+
+    // the layout of the CLI line: "0.97 MiB received, 452.22 KiB sent" is shown as "0.97 MiB ↓, 452.22 KiB ↑"
+    const QLocale locale;
+    if (m_trafficSource == TrafficSource::Cli) {
+        return QStringLiteral("%1 ↓, %2 ↑")
+                .arg(locale.formattedDataSize(qint64(m_rxBytes)), locale.formattedDataSize(qint64(m_txBytes)));
+    }
+
+    auto format = [&locale](quint64 bytes, double rate) {
+        return QStringLiteral("%1 (%2/s)").arg(locale.formattedDataSize(qint64(bytes)),
+                                               locale.formattedDataSize(qRound64(rate)));
+    };
+
+    return QStringLiteral("%1 ↓, %2 ↑").arg(format(m_rxBytes, m_rxRate), format(m_txBytes, m_txRate));
+}
+
+NordVpnInfo::TrafficSource NordVpnInfo::trafficSource() const
+{
+    return m_trafficSource;
+}
+
+quint64 NordVpnInfo::rxBytes() const
+{
+    return m_rxBytes;
+}
+
+quint64 NordVpnInfo::txBytes() const
+{
+    return m_txBytes;
+}
+
+double NordVpnInfo::rxRate() const
+{
+    return m_rxRate;
+}
+
+double NordVpnInfo::txRate() const
+{
+    return m_txRate;
+}
+
+bool NordVpnInfo::hasTrafficCounters() const
+{
+    return m_trafficSource == TrafficSource::Counters;
+}
+
+void NordVpnInfo::setTraffic(quint64 rxBytes, quint64 txBytes)
+{
+    m_trafficSource = TrafficSource::Cli;
+    m_rxBytes = rxBytes;
+    m_txBytes = txBytes;
+    m_rxRate = 0.f;
+    m_txRate = 0.f;
+}
+
+void NordVpnInfo::setTrafficCounters(quint64 rxBytes, quint64 txBytes, double rxRate, double txRate)
+{
+    m_trafficSource = TrafficSource::Counters;
+    m_rxBytes = rxBytes;
+    m_txBytes = txBytes;
+    m_rxRate = static_cast<float>(rxRate);
+    m_txRate = static_cast<float>(txRate);
+}
+
+void NordVpnInfo::clearTrafficCounters()
+{
+    if (m_trafficSource != TrafficSource::Counters) {
+        return;
+    }
+
+    m_trafficSource = TrafficSource::None;
+    m_rxBytes = 0;
+    m_txBytes = 0;
+    m_rxRate = 0.f;
+    m_txRate = 0.f;
 }
@@ -18,13 +18,14 @@
 #pragma once
 
 #include <QObject>
+#include <chrono>
 
 class NordVpnInfo
 {
     Q_GADGET
 
 public:
-    enum class Status
+    enum class Status : quint8
     {
         Unknown = 0,
         Disconnected,
@@ -34,37 +35,95 @@ public:
     };
     Q_ENUM(Status);
 
+    enum class TrafficSource : quint8
+    {
+        None = 0,
+        Cli,
+        Counters,
+    };
+
+    using Uptime = std::chrono::seconds;
+
     NordVpnInfo();
 
     void clear();
     bool operator==(const NordVpnInfo &other) const;
     bool operator!=(const NordVpnInfo &other) const;
+    bool sameStructure(const NordVpnInfo &other) const;
+    bool sameTelemetry(const NordVpnInfo &other) const;
+    // the structure followed by the telemetry lines, see composeHtml()
     QString toString() const;
+    // the status line and the connection details as HTML, without uptime and traffic
+    QString structureToString() const;
+    // uptime and traffic as plain text, one per line
+    QString telemetryToText() const;
+    // the single layout of the both parts, lets callers cache the structural one
+    static QString composeHtml(const QString &structureHtml, const QString &telemetryText);
 
     static NordVpnInfo fromString(const QString &text);
+    static NordVpnInfo fromString(QStringView text);
+    static size_t structuralFingerprint(QStringView text);
+    void updateTelemetry(QStringView text);
     static NordVpnInfo::Status textToStatus(const QString &from);
+    static NordVpnInfo::Status textToStatus(QStringView from);
     static QString statusToText(NordVpnInfo::Status from);
     static QString parseUptime(const QString &from);
+    static QString parseUptime(QStringView from);
+    static Uptime parseUptimeDuration(QStringView from);
+    static QString formatUptime(Uptime uptime);
+    static bool parseTraffic(QStringView from, quint64 &rxBytes, quint64 &txBytes);
+    static qsizetype internedCount();
+    static QString serverName(quint32 serverId);
 
     NordVpnInfo::Status status() const;
     void setStatus(NordVpnInfo::Status status);
 
+    QString server() const;
+    quint32 serverId() const;
     QString country() const;
     QString city() const;
+    QString ip() const;
+    QString technology() const;
+    QString protocol() const;
+
+    bool hasUptime() const;
+    Uptime uptime() const;
+
+    QString traffic() const;
+    TrafficSource trafficSource() const;
+    quint64 rxBytes() const;
+    quint64 txBytes() const;
+    double rxRate() const;
+    double txRate() const;
+    bool hasTrafficCounters() const;
+    void setTrafficCounters(quint64 rxBytes, quint64 txBytes, double rxRate, double txRate);
+    void clearTrafficCounters();
 
 private:
+    static bool isTunnelStatus(Status status);
+    static void appendField(QString &text, const QString &field, const QString &delim);
+    void appendStructure(QString &text) const;
+
     Status m_status;
-    QString m_server;
-    QString m_country;
-    QString m_city;
-    QString m_ip;
-    QString m_technology;
-    QString m_protocol;
-    QString m_traffic;
-    QString m_uptime;
+    TrafficSource m_trafficSource;
+    // ids in process-wide string pools, 0 is an empty string
+    quint32 m_server;
+    quint32 m_country;
+    quint32 m_city;
+    quint32 m_ip;
+    quint32 m_technology;
+    quint32 m_protocol;
+    float m_rxRate;
+    float m_txRate;
+    Uptime m_uptime;
+    quint64 m_rxBytes;
+    quint64 m_txBytes;
 
     static int MetaIdClass;
     static int MetaIdEnum;
+
+    void setField(QStringView key, QStringView value);
+    void setTraffic(quint64 rxBytes, quint64 txBytes);
 };
 
 Q_DECLARE_METATYPE(NordVpnInfo::Status)
@@ -21,38 +21,55 @@
 #include "actions/actionresultviewer.h"
 #include "actions/actionstorage.h"
 #include "app/common.h"
+#include "app/connectionhistory.h"
+#include "app/connectionstats.h"
 #include "app/menuholder.h"
 #include "app/statechecker.h"
 #include "app/trayicon.h"
 #include "cli/clicaller.h"
+#include "cli/cliresultcache.h"
+#include "geo/coordinatesresolver.h"
 #include "geo/serverschartview.h"
 #include "settings/appsettings.h"
 #include "settings/settingsdialog.h"
+#include "settings/settingsmanager.h"
 
 #include <QApplication>
-#include <QFutureWatcher>
+#include <QFileDialog>
 #include <QInputDialog>
+#include <QSaveFile>
 #include <QTimer>
-#include <QtConcurrentRun>
 
 NordVpnWraper::NordVpnWraper(QObject *parent)
     : QObject(parent)
     , m_bus(new CLICaller(this))
     , m_actions(new ActionStorage(this))
     , m_checker(new StateChecker(m_bus, AppSettings::Monitor->Interval->read().toInt()))
+    , m_stats(new ConnectionStats(ConnectionStats::defaultFilePath(), this))
     , m_trayIcon(new TrayIcon(this))
     , m_menuHolder(new MenuHolder(this))
     , m_pauseTimer(new QTimer(this))
     , m_paused(0)
     , m_mapView({})
+    , m_actGeoConnect()
 {
     connect(qApp, &QApplication::aboutToQuit, this, &NordVpnWraper::prepareQuit);
     connect(m_checker, &StateChecker::stateChanged, m_trayIcon, &TrayIcon::setState);
+    connect(m_checker, &StateChecker::telemetryChanged, m_trayIcon, &TrayIcon::setTelemetry);
+    m_trayIcon->setHistory(m_checker->history());
     connect(m_checker, &StateChecker::statusChanged, this, &NordVpnWraper::onStatusChanged);
+    connect(m_checker, &StateChecker::stateChanged, m_stats, &ConnectionStats::onStateChanged);
     connect(m_trayIcon, &QSystemTrayIcon::activated, this, &NordVpnWraper::onTrayIconActivated);
     connect(m_menuHolder, &MenuHolder::actionTriggered, this, &NordVpnWraper::onActionTriggered);
     connect(m_pauseTimer, &QTimer::timeout, this, &NordVpnWraper::onPauseTimer);
 
+    // the cache is read once here, loadSettings() only updates its TTLs
+    auto cache = new CLIResultCache(QString("%1/cli_cache.json").arg(SettingsManager::dirPath()));
+    cache->load();
+    m_bus->setCache(cache);
+
+    m_stats->load();
+
     m_trayIcon->setVisible(true);
 }
 
@@ -80,6 +97,11 @@ StateChecker *NordVpnWraper::stateChecker() const
     return m_checker;
 }
 
+ConnectionStats *NordVpnWraper::connectionStats() const
+{
+    return m_stats;
+}
+
 void NordVpnWraper::start()
 {
     const bool wasActive = m_checker->isActive();
@@ -99,11 +121,29 @@ void NordVpnWraper::start()
 
     TrayIcon::reloadIcons();
     m_trayIcon->updateIcon(m_checker->state().status());
+
+    // open the places database in background once the UI is up, so the map doesn't wait for it
+    QTimer::singleShot(0, this, []() { CoordinatesResolver::warmUp(); });
 }
 
 void NordVpnWraper::loadSettings()
 {
     m_checker->setInterval(AppSettings::Monitor->Interval->read().toInt());
+    m_checker->setIntervalBounds(AppSettings::Monitor->IntervalMin->read().toInt(),
+                                 AppSettings::Monitor->IntervalMax->read().toInt());
+    m_checker->setAdaptive(AppSettings::Monitor->AdaptiveInterval->read().toBool());
+    m_checker->setKernelEvents(AppSettings::Monitor->KernelEvents->read().toBool());
+    m_checker->setTrafficInterval(AppSettings::Monitor->TrafficInterval->read().toInt());
+    m_checker->setTelemetryInterval(AppSettings::Monitor->TelemetryInterval->read().toInt());
+
+    m_bus->executor()->setLimit(CLIExecutor::Lane::Bulk, AppSettings::Monitor->BulkParallelism->read().toInt());
+
+    if (auto cache = m_bus->cache()) {
+        cache->setTtl(QStringLiteral("groups"), AppSettings::Monitor->CacheTtlGroups->read().toInt());
+        cache->setTtl(QStringLiteral("countries"), AppSettings::Monitor->CacheTtlCountries->read().toInt());
+        cache->setTtl(QStringLiteral("cities"), AppSettings::Monitor->CacheTtlCities->read().toInt());
+    }
+
     m_trayIcon->setMessageDuration(AppSettings::Tray->MessageDuration->read().toInt() * utils::oneSecondMs());
 
     if (AppSettings::Map->Visible->read().toBool())
@@ -228,6 +268,9 @@ void NordVpnWraper::processYangleAction(Action *action)
         qApp->quit();
         break;
     }
+    case Action::Yangl::ExportHistory:
+        exportHistory();
+        break;
     default:
         break;
     }
@@ -238,6 +281,7 @@ void NordVpnWraper::processUserAction(Action *action)
     if (!isAcceptableAction(action, Action::Flow::Custom, Q_FUNC_INFO))
         return;
 
+    m_checker->boost();
     m_bus->performAction(action);
 }
 
@@ -255,10 +299,17 @@ void NordVpnWraper::processNordVpnAction(Action *action)
         pause(actType);
         return;
     }
+    case Action::NordVPN::Connect: {
+        // the location is known once connected
+        connect(action, &Action::performed, this, &NordVpnWraper::onConnectPerformed, Qt::UniqueConnection);
+        m_stats->begin({}, {}, QDateTime::currentMSecsSinceEpoch());
+        break;
+    }
     default:
         break;
     }
 
+    m_checker->boost();
     m_bus->performAction(action);
 }
 
@@ -396,36 +447,37 @@ void NordVpnWraper::connectTo(const QString &country, const QString &city)
 {
     LOG << country << city;
 
-    auto future = QtConcurrent::run([country, city, this]() -> bool {
-        try {
-            const Action::Ptr &action = storate()->createUserAction({});
-            action->setTitle(tr("Geo Connection"));
-            action->setForcedShow(false);
-            action->setArgs({ "c", country == utils::groupsTitle() ? "-g" : country, city });
-            if (auto call = action->createRequest()) {
-                call->run();
-            }
-            return true; // Success
-        } catch (const std::exception &e) {
-            WRN << "Exception in async task:" << e.what();
-            return false; // Failure
-        } catch (...) {
-            WRN << "Unknown error in async task!";
-            return false;
-        }
-    });
-
-    // Check result when available
-    auto *watcher = new QFutureWatcher<bool>(this);
-    QObject::connect(watcher, &QFutureWatcher<bool>::finished, this, [future, watcher]() {
-        if (!future.result()) { // If false, an error occurred
-            WRN << "Async task failed!";
-        } else {
-            WRN << "Async task completed successfully.";
-        }
-        watcher->deleteLater();
-    });
-    watcher->setFuture(future);
+    if (!m_actGeoConnect) {
+        m_actGeoConnect = storate()->createUserAction({});
+        m_actGeoConnect->setTitle(tr("Geo Connection"));
+        m_actGeoConnect->setForcedShow(false);
+        connect(m_actGeoConnect.get(), &Action::performed, this, &NordVpnWraper::onConnectPerformed);
+    }
+
+    const bool isGroup = country == utils::groupsTitle();
+    m_stats->begin(isGroup ? QString() : country, isGroup ? QString() : city, QDateTime::currentMSecsSinceEpoch());
+
+    m_actGeoConnect->setApp(AppSettings::Monitor->NVPNPath->read().toString());
+    m_actGeoConnect->setArgs({ "c", isGroup ? "-g" : country, city });
+    m_checker->boost();
+    m_bus->performAction(m_actGeoConnect.get(), CLIExecutor::Lane::Interactive);
+}
+
+void NordVpnWraper::connectToFastest(const QString &country)
+{
+    const QString &city = m_stats->fastestCity(country);
+    LOG << country << "fastest:" << city << m_stats->summary(country, city).toString();
+
+    connectTo(country, utils::geoToNvpn(city));
+}
+
+void NordVpnWraper::onConnectPerformed(const Action::Id & /*id*/, const QString & /*result*/, bool ok,
+                                       const QString &description)
+{
+    if (!ok) {
+        WRN << "connection failed:" << description;
+        m_stats->fail();
+    }
 }
 
 void NordVpnWraper::showMapView()
@@ -454,3 +506,25 @@ void NordVpnWraper::showAbout()
 {
     AboutDialog::makeVisible(nullptr);
 }
+
+void NordVpnWraper::exportHistory()
+{
+    const QString &filePath = QFileDialog::getSaveFileName(
+            nullptr, tr("Export connection history"), QStringLiteral("yangl-history.csv"), tr("CSV files (*.csv)"));
+    if (filePath.isEmpty())
+        return;
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        WRN << "failed to open" << filePath << file.errorString();
+        return;
+    }
+
+    const qsizetype rows = m_checker->history()->exportCsv(&file);
+    if (rows < 0 || !file.commit()) {
+        WRN << "failed to export the history to" << filePath << file.errorString();
+        return;
+    }
+
+    LOG << "exported" << rows << "history samples to" << filePath;
+}
@@ -26,6 +26,7 @@
 
 class CLICaller;
 class ActionStorage;
+class ConnectionStats;
 class StateChecker;
 class MenuHolder;
 class QTimer;
@@ -42,8 +43,10 @@ public:
     CLICaller *bus() const;
     ActionStorage *storate() const;
     StateChecker *stateChecker() const;
+    ConnectionStats *connectionStats() const;
 
     void connectTo(const QString &country, const QString &city);
+    void connectToFastest(const QString &country);
 
 private slots:
     void prepareQuit();
@@ -52,6 +55,7 @@ private slots:
     void showSettingsEditor();
     void showLog();
     void showAbout();
+    void exportHistory();
 
     void performStatusCheck();
 
@@ -60,16 +64,19 @@ private slots:
     void onActionTriggered(Action *action);
     void onStatusChanged(NordVpnInfo::Status status);
     void onPauseTimer();
+    void onConnectPerformed(const Action::Id &id, const QString &result, bool ok, const QString &description);
 
 private:
     CLICaller *m_bus;
     ActionStorage *m_actions;
     StateChecker *m_checker;
+    ConnectionStats *m_stats;
     TrayIcon *m_trayIcon;
     MenuHolder *m_menuHolder;
     QTimer *m_pauseTimer;
     int m_paused;
     QPointer<QWidget> m_mapView;
+    Action::Ptr m_actGeoConnect;
     void loadSettings();
 
     void pause(Action::NordVPN action);
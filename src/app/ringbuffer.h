@@ -0,0 +1,75 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include <QtGlobal>
+#include <vector>
+
+template<typename T>
+class RingBuffer
+{
+public:
+    explicit RingBuffer(qsizetype capacity)
+        : m_data(static_cast<size_t>(qMax<qsizetype>(1, capacity)))
+    {
+    }
+
+    qsizetype capacity() const { return static_cast<qsizetype>(m_data.size()); }
+    qsizetype size() const { return m_size; }
+    bool isEmpty() const { return !m_size; }
+    bool isFull() const { return m_size == capacity(); }
+
+    void clear()
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+    // returns true if the oldest element had to be overwritten
+    bool push(const T &value, T *evicted = nullptr)
+    {
+        if (isFull()) {
+            T &slot = m_data[static_cast<size_t>(m_head)];
+            if (evicted) {
+                *evicted = slot;
+            }
+            slot = value;
+            m_head = (m_head + 1) % capacity();
+            return true;
+        }
+
+        m_data[static_cast<size_t>((m_head + m_size) % capacity())] = value;
+        ++m_size;
+        return false;
+    }
+
+    // 0 is the oldest element
+    const T &at(qsizetype i) const
+    {
+        Q_ASSERT(i >= 0 && i < m_size);
+        return m_data[static_cast<size_t>((m_head + i) % capacity())];
+    }
+
+    const T &first() const { return at(0); }
+    const T &last() const { return at(m_size - 1); }
+
+private:
+    std::vector<T> m_data;
+    qsizetype m_head = 0;
+    qsizetype m_size = 0;
+};
@@ -18,24 +18,54 @@
 #include "statechecker.h"
 
 #include "app/common.h"
+#include "app/connectionhistory.h"
+#include "app/netlinkwatcher.h"
 #include "cli/clicaller.h"
 #include "settings/appsettings.h"
 
-#include <QFutureWatcher>
+#include <QDateTime>
+#include <QFuture>
 #include <QTimer>
 #include <QtConcurrentRun>
 
 /*static*/ const int StateChecker::DefaultIntervalMs = utils::oneSecondMs();
+/*static*/ const int StateChecker::DefaultMinIntervalMs = utils::oneSecondMs();
+/*static*/ const int StateChecker::DefaultMaxIntervalMs = 30 * utils::oneSecondMs();
+/*static*/ const int StateChecker::DefaultTelemetryIntervalMs = 2 * utils::oneSecondMs();
 
 StateChecker::StateChecker(CLICaller *bus, int intervalMs)
     : QObject()
     , m_bus(bus)
     , m_actCheck(nullptr)
     , m_timer(new QTimer(this))
+    , m_active(false)
+    , m_adaptive(false)
+    , m_intervalMs(intervalMs)
+    , m_minIntervalMs(DefaultMinIntervalMs)
+    , m_maxIntervalMs(DefaultMaxIntervalMs)
+    , m_currentIntervalMs(intervalMs)
+    , m_netlink(nullptr)
+    , m_traffic(new TrafficMonitor(this))
+    , m_history(new ConnectionHistory(ConnectionHistory::DefaultRecentCapacity,
+                                      ConnectionHistory::DefaultArchiveCapacity,
+                                      ConnectionHistory::DefaultDownsampleFactor, this))
+    , m_trafficIntervalMs(TrafficMonitor::DefaultIntervalMs)
+    , m_telemetryTimer(new QTimer(this))
+    , m_telemetryIntervalMs(DefaultTelemetryIntervalMs)
+    , m_sequence(0)
+    , m_deliveredSequence(0)
+    , m_published(std::make_shared<SnapshotSlot>())
+    , m_fingerprintValid(false)
     , m_state()
 {
-    setInterval(intervalMs);
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::CoarseTimer);
     connect(m_timer, &QTimer::timeout, this, &StateChecker::onTimeout);
+    connect(m_traffic, &TrafficMonitor::sampleChanged, this, &StateChecker::onTrafficSample);
+
+    m_telemetryTimer->setSingleShot(true);
+    m_telemetryTimer->setTimerType(Qt::CoarseTimer);
+    connect(m_telemetryTimer, &QTimer::timeout, this, &StateChecker::onTelemetryTimeout);
 
     setStatus(NordVpnInfo::Status::Unknown);
 }
@@ -54,11 +84,13 @@ void StateChecker::setCheckAction(const Action::Ptr &action)
 
 void StateChecker::setActive(bool active)
 {
-    if (m_timer->isActive() != active) {
+    if (m_active != active) {
+        m_active = active;
 
         if (active) {
+            m_currentIntervalMs = m_adaptive ? m_minIntervalMs : m_intervalMs;
             check();
-            m_timer->start();
+            schedule(m_currentIntervalMs);
         } else {
             m_timer->stop();
             setStatus(NordVpnInfo::Status::Unknown);
@@ -70,59 +102,340 @@ void StateChecker::setActive(bool active)
 
 bool StateChecker::isActive() const
 {
-    return m_timer->isActive();
+    return m_active;
 }
 
 void StateChecker::setInterval(int msecs)
 {
-    const bool wasActive(isActive());
-
-    m_timer->stop();
-    m_timer->setInterval(msecs);
+    m_intervalMs = msecs;
 
-    if (wasActive)
-        m_timer->start();
+    if (!m_adaptive) {
+        m_currentIntervalMs = m_intervalMs;
+        schedule(m_currentIntervalMs);
+    }
 }
 
 int StateChecker::interval() const
 {
-    return m_timer->interval();
+    return m_intervalMs;
+}
+
+void StateChecker::setAdaptive(bool adaptive)
+{
+    if (m_adaptive != adaptive) {
+        m_adaptive = adaptive;
+        m_currentIntervalMs = m_adaptive ? m_minIntervalMs : m_intervalMs;
+        schedule(m_currentIntervalMs);
+    }
+}
+
+bool StateChecker::isAdaptive() const
+{
+    return m_adaptive;
+}
+
+void StateChecker::setIntervalBounds(int minMsecs, int maxMsecs)
+{
+    m_minIntervalMs = qMax(1, minMsecs);
+    m_maxIntervalMs = qMax(m_minIntervalMs, maxMsecs);
+
+    if (m_adaptive) {
+        m_currentIntervalMs = qBound(m_minIntervalMs, m_currentIntervalMs, m_maxIntervalMs);
+        schedule(m_currentIntervalMs);
+    }
+}
+
+int StateChecker::minInterval() const
+{
+    return m_minIntervalMs;
+}
+
+int StateChecker::maxInterval() const
+{
+    return m_maxIntervalMs;
+}
+
+int StateChecker::currentInterval() const
+{
+    return m_currentIntervalMs;
+}
+
+void StateChecker::boost()
+{
+    if (!m_adaptive) {
+        return;
+    }
+
+    m_currentIntervalMs = m_minIntervalMs;
+    if (m_active && m_timer->remainingTime() > m_currentIntervalMs) {
+        schedule(m_currentIntervalMs);
+    }
+}
+
+void StateChecker::setKernelEvents(bool enabled)
+{
+    if (kernelEvents() == enabled) {
+        return;
+    }
+
+    if (!enabled) {
+        delete m_netlink;
+        m_netlink = nullptr;
+        return;
+    }
+
+    if (!NetlinkWatcher::isSupported()) {
+        return;
+    }
+
+    auto *watcher = new NetlinkWatcher(this);
+    if (!watcher->start()) {
+        WRN << "Kernel link events are unavailable, relying on polling";
+        delete watcher;
+        return;
+    }
+
+    m_netlink = watcher;
+    connect(m_netlink, &NetlinkWatcher::changed, this, &StateChecker::onKernelEvent);
+}
+
+bool StateChecker::kernelEvents() const
+{
+    return m_netlink != nullptr;
+}
+
+void StateChecker::onKernelEvent()
+{
+    if (!m_active) {
+        return;
+    }
+
+    boost();
+    check();
+}
+
+TrafficMonitor *StateChecker::trafficMonitor() const
+{
+    return m_traffic;
+}
+
+ConnectionHistory *StateChecker::history() const
+{
+    return m_history;
+}
+
+void StateChecker::recordHistory()
+{
+    m_history->append(m_state, QDateTime::currentMSecsSinceEpoch());
+}
+
+int StateChecker::trafficInterval() const
+{
+    return m_trafficIntervalMs;
+}
+
+void StateChecker::setTrafficInterval(int msecs)
+{
+    m_trafficIntervalMs = qMax(0, msecs);
+    if (m_trafficIntervalMs) {
+        m_traffic->setInterval(m_trafficIntervalMs);
+    }
+
+    m_traffic->stop();
+    updateTrafficMonitor();
+}
+
+void StateChecker::updateTrafficMonitor()
+{
+    const bool wanted = m_trafficIntervalMs > 0 && m_state.status() == NordVpnInfo::Status::Connected;
+    if (wanted == m_traffic->isActive()) {
+        return;
+    }
+
+    if (wanted) {
+        m_traffic->start();
+    } else {
+        m_traffic->stop();
+    }
+}
+
+void StateChecker::applyTraffic(NordVpnInfo &state) const
+{
+    const TrafficMonitor::Sample &sample = m_traffic->sample();
+    if (m_traffic->isActive() && sample.valid && state.status() == NordVpnInfo::Status::Connected) {
+        state.setTrafficCounters(sample.rxBytes, sample.txBytes, sample.rxRate, sample.txRate);
+    } else {
+        state.clearTrafficCounters();
+    }
+}
+
+void StateChecker::onTrafficSample(const TrafficMonitor::Sample & /*sample*/)
+{
+    NordVpnInfo state = m_state;
+    applyTraffic(state);
+    setState(state);
+}
+
+int StateChecker::telemetryInterval() const
+{
+    return m_telemetryIntervalMs;
+}
+
+void StateChecker::setTelemetryInterval(int msecs)
+{
+    m_telemetryIntervalMs = qMax(0, msecs);
+}
+
+void StateChecker::publishTelemetry()
+{
+    if (m_telemetryTimer->isActive()) {
+        return;
+    }
+
+    if (!m_telemetryIntervalMs || !m_telemetryClock.isValid() || m_telemetryClock.hasExpired(m_telemetryIntervalMs)) {
+        onTelemetryTimeout();
+    } else {
+        m_telemetryTimer->start(m_telemetryIntervalMs - static_cast<int>(m_telemetryClock.elapsed()));
+    }
+}
+
+void StateChecker::onTelemetryTimeout()
+{
+    m_telemetryClock.start();
+    emit telemetryChanged(m_state);
+}
+
+void StateChecker::schedule(int msecs)
+{
+    if (m_active) {
+        m_timer->start(msecs);
+    }
 }
 
 void StateChecker::check()
 {
-    m_bus->performAction(m_actCheck.get());
+    m_bus->performAction(m_actCheck.get(), CLIExecutor::Lane::Polling);
 }
 
 void StateChecker::onQueryFinish(const Action::Id & /*id*/, const QString &result, bool /*ok*/,
                                  const QString & /*info*/)
 {
-    auto future = QtConcurrent::run([this, result]() {
-        try {
-            updateState(result);
-        } catch (const std::exception &e) {
-            WRN << "Exception in async task:" << e.what();
+    const quint64 sequence = ++m_sequence;
+    const size_t fingerprint = NordVpnInfo::structuralFingerprint(result);
+    if (updateTelemetryOnly(sequence, fingerprint, result)) {
+        return;
+    }
+
+    QtConcurrent::run([slot = m_published, sequence, fingerprint, result]() {
+        auto snapshot = std::make_shared<Snapshot>();
+        snapshot->sequence = sequence;
+        snapshot->fingerprint = fingerprint;
+        snapshot->info = NordVpnInfo::fromString(result);
+        return publish(*slot, snapshot);
+    }).then(this, [this](bool published) {
+        if (published) {
+            deliverSnapshot();
         }
     });
+}
 
-    auto *watcher = new QFutureWatcher<void>(this);
-    QObject::connect(watcher, &QFutureWatcher<void>::finished, this, [future, watcher]() {
-        if (future.isCanceled()) {
-            WRN << "Async task was canceled!";
+/*static*/ bool StateChecker::publish(SnapshotSlot &slot, const Snapshot::Ptr &snapshot)
+{
+    // may be called from any thread; results of older queries never replace newer ones
+    Snapshot::Ptr current = slot.load();
+    do {
+        if (current && current->sequence >= snapshot->sequence) {
+            return false;
         }
-        watcher->deleteLater();
-    });
-    watcher->setFuture(future);
+    } while (!slot.compare_exchange_weak(current, snapshot));
+
+    return true;
+}
+
+void StateChecker::deliverSnapshot()
+{
+    const Snapshot::Ptr snapshot = m_published->load();
+    if (!snapshot || snapshot->sequence <= m_deliveredSequence) {
+        return;
+    }
+
+    m_deliveredSequence = snapshot->sequence;
+    m_fingerprintValid = true;
+
+    NordVpnInfo state = snapshot->info;
+    applyTraffic(state);
+
+    const NordVpnInfo previous = m_state;
+    setState(state);
+
+    adaptInterval(previous.status() != m_state.status() || previous.country() != m_state.country()
+                  || previous.city() != m_state.city());
+}
+
+bool StateChecker::updateTelemetryOnly(quint64 sequence, size_t fingerprint, const QString &result)
+{
+    // only valid when the latest published snapshot is the one m_state came from
+    const Snapshot::Ptr latest = m_published->load();
+    const bool hit = m_fingerprintValid && latest && latest->sequence == m_deliveredSequence
+            && m_deliveredSequence + 1 == sequence && latest->fingerprint == fingerprint;
+    if (!hit) {
+        ++m_fingerprintStats.misses;
+        return false;
+    }
+
+    ++m_fingerprintStats.hits;
+
+    NordVpnInfo state = m_state;
+    state.updateTelemetry(result);
+    applyTraffic(state);
+
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->sequence = sequence;
+    snapshot->fingerprint = fingerprint;
+    snapshot->info = state;
+    publish(*m_published, snapshot);
+    m_deliveredSequence = sequence;
+
+    if (!m_state.sameTelemetry(state)) {
+        m_state = state;
+        recordHistory();
+        publishTelemetry();
+    }
+    adaptInterval(false);
+
+    return true;
+}
+
+StateChecker::FingerprintStats StateChecker::fingerprintStats() const
+{
+    return m_fingerprintStats;
+}
+
+StateChecker::Snapshot::Ptr StateChecker::snapshot() const
+{
+    return m_published->load();
 }
 
 void StateChecker::onTimeout()
 {
     check();
+    schedule(m_currentIntervalMs);
 }
 
-void StateChecker::updateState(const QString &from)
+void StateChecker::adaptInterval(bool changed)
 {
-    setState(NordVpnInfo::fromString(from));
+    if (!m_adaptive) {
+        return;
+    }
+
+    const bool transition = m_state.status() == NordVpnInfo::Status::Connecting
+            || m_state.status() == NordVpnInfo::Status::Disconnecting;
+
+    if (changed || transition) {
+        boost();
+    } else {
+        m_currentIntervalMs = qMin(m_maxIntervalMs, m_currentIntervalMs * BackoffFactor);
+    }
 }
 
 NordVpnInfo StateChecker::state() const
@@ -132,19 +445,34 @@ NordVpnInfo StateChecker::state() const
 
 void StateChecker::setState(const NordVpnInfo &state)
 {
-    if (this->state() != state) {
-        if (m_state.status() != state.status() || m_state.country() != state.country()
-            || m_state.city() != state.city())
-            emit statusChanged(state.status());
+    if (this->state() == state) {
+        return;
+    }
 
+    if (m_state.sameStructure(state)) {
         m_state = state;
-        emit stateChanged(m_state);
+        recordHistory();
+        publishTelemetry();
+        return;
     }
+
+    if (m_state.status() != state.status() || m_state.country() != state.country() || m_state.city() != state.city())
+        emit statusChanged(state.status());
+
+    m_state = state;
+    recordHistory();
+    m_telemetryTimer->stop();
+    m_telemetryClock.start();
+    emit stateChanged(m_state);
+
+    updateTrafficMonitor();
 }
 
 void StateChecker::setStatus(NordVpnInfo::Status status)
 {
     if (m_state.status() != status) {
+        m_fingerprintValid = false;
+
         NordVpnInfo state;
         if (status != NordVpnInfo::Status::Unknown)
             state = m_state;
@@ -19,10 +19,16 @@
 
 #include "actions/action.h"
 #include "app/nordvpninfo.h"
+#include "app/trafficmonitor.h"
 
+#include <QElapsedTimer>
 #include <QObject>
+#include <atomic>
+#include <memory>
 
 class CLICaller;
+class ConnectionHistory;
+class NetlinkWatcher;
 class QTimer;
 
 class StateChecker : public QObject
@@ -30,8 +36,26 @@ class StateChecker : public QObject
     Q_OBJECT
 public:
     static const int DefaultIntervalMs;
+    static const int DefaultMinIntervalMs;
+    static const int DefaultMaxIntervalMs;
+    static constexpr int BackoffFactor = 2;
+    static const int DefaultTelemetryIntervalMs;
 
     using Ptr = QSharedPointer<StateChecker>;
+
+    struct Snapshot {
+        using Ptr = std::shared_ptr<const Snapshot>;
+
+        quint64 sequence = 0;
+        size_t fingerprint = 0;
+        NordVpnInfo info;
+    };
+    using SnapshotSlot = std::atomic<Snapshot::Ptr>;
+
+    struct FingerprintStats {
+        quint64 hits = 0;
+        quint64 misses = 0;
+    };
     explicit StateChecker(CLICaller *bus, int intervalMs);
     ~StateChecker() override;
 
@@ -41,29 +65,79 @@ public:
     bool isActive() const;
     int interval() const;
     NordVpnInfo state() const;
+    Snapshot::Ptr snapshot() const;
+    FingerprintStats fingerprintStats() const;
+
+    bool isAdaptive() const;
+    int minInterval() const;
+    int maxInterval() const;
+    int currentInterval() const;
+
+    bool kernelEvents() const;
+
+    TrafficMonitor *trafficMonitor() const;
+    ConnectionHistory *history() const;
+    int trafficInterval() const;
+    int telemetryInterval() const;
 
 public slots:
     void setInterval(int msecs);
     void setActive(bool active);
+    void setAdaptive(bool adaptive);
+    void setIntervalBounds(int minMsecs, int maxMsecs);
+    void boost();
+    void setKernelEvents(bool enabled);
+    void setTrafficInterval(int msecs);
+    void setTelemetryInterval(int msecs);
 
 signals:
     void stateChanged(const NordVpnInfo &state);
+    void telemetryChanged(const NordVpnInfo &state);
     void statusChanged(const NordVpnInfo::Status status);
 
 private slots:
     void onTimeout();
+    void onKernelEvent();
+    void onTrafficSample(const TrafficMonitor::Sample &sample);
+    void onTelemetryTimeout();
+    void deliverSnapshot();
     void onQueryFinish(const Action::Id &id, const QString &result, bool ok, const QString &info);
 
 protected:
     CLICaller *m_bus;
     Action::Ptr m_actCheck;
     QTimer *m_timer;
+    bool m_active;
+    bool m_adaptive;
+    int m_intervalMs;
+    int m_minIntervalMs;
+    int m_maxIntervalMs;
+    int m_currentIntervalMs;
+    NetlinkWatcher *m_netlink;
+    TrafficMonitor *m_traffic;
+    ConnectionHistory *m_history;
+    int m_trafficIntervalMs;
+    QTimer *m_telemetryTimer;
+    int m_telemetryIntervalMs;
+    QElapsedTimer m_telemetryClock;
+    quint64 m_sequence;
+    quint64 m_deliveredSequence;
+    const std::shared_ptr<SnapshotSlot> m_published;
+    bool m_fingerprintValid;
+    FingerprintStats m_fingerprintStats;
 
     NordVpnInfo m_state;
     void setState(const NordVpnInfo &state);
     void setStatus(NordVpnInfo::Status status);
 
-    void updateState(const QString &from);
+    static bool publish(SnapshotSlot &slot, const Snapshot::Ptr &snapshot);
+    bool updateTelemetryOnly(quint64 sequence, size_t fingerprint, const QString &result);
+    void adaptInterval(bool changed);
+    void schedule(int msecs);
+    void updateTrafficMonitor();
+    void applyTraffic(NordVpnInfo &state) const;
+    void publishTelemetry();
+    void recordHistory();
 
     friend class TestStateChecker;
     friend class NordVpnWraper;
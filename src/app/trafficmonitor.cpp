@@ -0,0 +1,188 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "trafficmonitor.h"
+
+#include "app/common.h"
+#include "app/netlinkwatcher.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTimer>
+
+/*static*/ const QString TrafficMonitor::DefaultSysfsRoot = QStringLiteral("/sys/class/net");
+/*static*/ const int TrafficMonitor::DefaultIntervalMs = utils::oneSecondMs();
+
+TrafficMonitor::TrafficMonitor(QObject *parent)
+    : QObject(parent)
+    , m_sysfsRoot(DefaultSysfsRoot)
+    , m_prefixes(NetlinkWatcher::DefaultInterfacePrefixes)
+    , m_timer(new QTimer(this))
+{
+    qRegisterMetaType<TrafficMonitor::Sample>();
+
+    m_timer->setInterval(DefaultIntervalMs);
+    m_timer->setTimerType(Qt::CoarseTimer);
+    connect(m_timer, &QTimer::timeout, this, &TrafficMonitor::poll);
+}
+
+QString TrafficMonitor::sysfsRoot() const
+{
+    return m_sysfsRoot;
+}
+
+void TrafficMonitor::setSysfsRoot(const QString &path)
+{
+    m_sysfsRoot = path;
+}
+
+QStringList TrafficMonitor::interfacePrefixes() const
+{
+    return m_prefixes;
+}
+
+void TrafficMonitor::setInterfacePrefixes(const QStringList &prefixes)
+{
+    m_prefixes = prefixes;
+}
+
+QString TrafficMonitor::interfaceName() const
+{
+    return m_forcedInterface.isEmpty() ? m_sample.iface : m_forcedInterface;
+}
+
+void TrafficMonitor::setInterfaceName(const QString &name)
+{
+    m_forcedInterface = name;
+}
+
+int TrafficMonitor::interval() const
+{
+    return m_timer->interval();
+}
+
+void TrafficMonitor::setInterval(int msecs)
+{
+    m_timer->setInterval(qMax(1, msecs));
+}
+
+bool TrafficMonitor::isActive() const
+{
+    return m_timer->isActive();
+}
+
+TrafficMonitor::Sample TrafficMonitor::sample() const
+{
+    return m_sample;
+}
+
+void TrafficMonitor::start()
+{
+    if (isActive()) {
+        return;
+    }
+
+    m_sample = {};
+    m_clock.invalidate();
+    m_timer->start();
+    poll();
+}
+
+void TrafficMonitor::stop()
+{
+    m_timer->stop();
+
+    if (m_sample.valid) {
+        m_sample = {};
+        emit sampleChanged(m_sample);
+    }
+}
+
+QString TrafficMonitor::findInterface() const
+{
+    const QStringList &names = QDir(m_sysfsRoot).entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::System);
+    for (const QString &prefix : m_prefixes) {
+        for (const QString &name : names) {
+            if (name.startsWith(prefix)) {
+                return name;
+            }
+        }
+    }
+
+    return {};
+}
+
+bool TrafficMonitor::readCounter(const QString &iface, const QString &name, quint64 &value) const
+{
+    QFile file(QStringLiteral("%1/%2/statistics/%3").arg(m_sysfsRoot, iface, name));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    char buffer[32] = {};
+    const qint64 len = file.read(buffer, sizeof(buffer) - 1);
+    if (len <= 0) {
+        return false;
+    }
+
+    bool ok(false);
+    value = QByteArrayView(buffer, len).trimmed().toULongLong(&ok);
+    return ok;
+}
+
+bool TrafficMonitor::poll()
+{
+    Sample current;
+    auto read = [this, &current](const QString &iface) {
+        current.iface = iface;
+        current.valid = !iface.isEmpty() && readCounter(iface, QStringLiteral("rx_bytes"), current.rxBytes)
+                && readCounter(iface, QStringLiteral("tx_bytes"), current.txBytes);
+        return current.valid;
+    };
+
+    if (!m_forcedInterface.isEmpty()) {
+        read(m_forcedInterface);
+    } else if (!m_sample.valid || !read(m_sample.iface)) {
+        // the tunnel might have been re-created under another name
+        read(findInterface());
+    }
+
+    qint64 elapsedMs(0);
+    if (m_clock.isValid()) {
+        elapsedMs = m_clock.restart();
+    } else {
+        m_clock.start();
+    }
+
+    if (current.valid && m_sample.valid && current.iface == m_sample.iface && elapsedMs > 0) {
+        const double secs = elapsedMs / double(utils::oneSecondMs());
+        // counters drop back to zero when the interface is re-created
+        current.rxRate = current.rxBytes >= m_sample.rxBytes ? (current.rxBytes - m_sample.rxBytes) / secs : 0.;
+        current.txRate = current.txBytes >= m_sample.txBytes ? (current.txBytes - m_sample.txBytes) / secs : 0.;
+    }
+
+    const bool changed = current.valid != m_sample.valid || current.rxBytes != m_sample.rxBytes
+            || current.txBytes != m_sample.txBytes || current.rxRate != m_sample.rxRate
+            || current.txRate != m_sample.txRate;
+
+    m_sample = current;
+    if (changed) {
+        emit sampleChanged(m_sample);
+    }
+
+    return m_sample.valid;
+}
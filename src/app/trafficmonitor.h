@@ -0,0 +1,80 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QStringList>
+
+class QTimer;
+
+class TrafficMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    static const QString DefaultSysfsRoot;
+    static const int DefaultIntervalMs;
+
+    struct Sample {
+        QString iface;
+        quint64 rxBytes = 0;
+        quint64 txBytes = 0;
+        double rxRate = 0.; // bytes per second
+        double txRate = 0.;
+        bool valid = false;
+    };
+
+    explicit TrafficMonitor(QObject *parent = {});
+
+    QString sysfsRoot() const;
+    void setSysfsRoot(const QString &path);
+
+    QStringList interfacePrefixes() const;
+    void setInterfacePrefixes(const QStringList &prefixes);
+
+    QString interfaceName() const;
+    void setInterfaceName(const QString &name);
+
+    int interval() const;
+    void setInterval(int msecs);
+
+    bool isActive() const;
+    Sample sample() const;
+
+    QString findInterface() const;
+
+public slots:
+    void start();
+    void stop();
+    bool poll();
+
+signals:
+    void sampleChanged(const TrafficMonitor::Sample &sample);
+
+private:
+    QString m_sysfsRoot;
+    QStringList m_prefixes;
+    QString m_forcedInterface;
+    QTimer *m_timer;
+    QElapsedTimer m_clock;
+    Sample m_sample;
+
+    bool readCounter(const QString &iface, const QString &name, quint64 &value) const;
+};
+
+Q_DECLARE_METATYPE(TrafficMonitor::Sample)
@@ -17,6 +17,7 @@
 
 #include "trayicon.h"
 
+#include "app/connectionhistory.h"
 #include "settings/appsettings.h"
 
 #include <QApplication>
@@ -97,6 +98,7 @@
 
 TrayIcon::TrayIcon(QObject *parent)
     : QSystemTrayIcon(iconForStatus(NordVpnInfo::Status::Unknown), parent)
+    , m_history(nullptr)
     , m_isFirstChange(true)
 {
     deployDefaults();
@@ -130,29 +132,82 @@ void TrayIcon::updateIcon(NordVpnInfo::Status status)
 
 void TrayIcon::setState(const NordVpnInfo &state)
 {
-    const auto &stateText = state.toString();
+    render(state);
+
     if (m_state.status() != state.status() && !qApp->isSavingSession()) {
         updateIcon(state.status());
 
-        bool skeepMessage(false);
-        if (m_isFirstChange && state.status() == NordVpnInfo::Status::Connected)
-            if (AppSettings::Monitor->Active->read().toBool()
-                && AppSettings::Tray->IgnoreFirstConnected->read().toBool()) {
-                skeepMessage = true;
-            }
+        const bool skipMessage = m_isFirstChange && state.status() == NordVpnInfo::Status::Connected
+                && AppSettings::Monitor->Active->read().toBool()
+                && AppSettings::Tray->IgnoreFirstConnected->read().toBool();
 
-        if (!skeepMessage) {
-            const QString &description = AppSettings::Tray->MessagePlainText->read().toBool()
-                    ? QTextDocumentFragment::fromHtml(stateText).toPlainText()
-                    : stateText;
+        if (!skipMessage) {
+            const QString &description =
+                    AppSettings::Tray->MessagePlainText->read().toBool() ? m_rendered.text : messageHtml();
             showMessage(qApp->applicationDisplayName(), description, iconForState(state), m_duration);
         }
     }
 
-    setToolTip(QTextDocumentFragment::fromHtml(stateText).toPlainText()); // always plaintext
-
     m_state = state;
     m_isFirstChange = false;
+
+    updateToolTip();
+}
+
+void TrayIcon::setTelemetry(const NordVpnInfo &state)
+{
+    render(state);
+    m_state = state;
+    updateToolTip();
+}
+
+void TrayIcon::setHistory(const ConnectionHistory *history)
+{
+    m_history = history;
+    m_rendered.toolTipDirty = true;
+}
+
+void TrayIcon::render(const NordVpnInfo &state)
+{
+    const bool structureChanged = !m_rendered.valid || !m_rendered.state.sameStructure(state);
+    if (!structureChanged && m_rendered.state.sameTelemetry(state)) {
+        return;
+    }
+
+    if (structureChanged) {
+        m_rendered.structureHtml = state.structureToString();
+        m_rendered.structureText = QTextDocumentFragment::fromHtml(m_rendered.structureHtml).toPlainText();
+    }
+
+    m_rendered.valid = true;
+    m_rendered.state = state;
+    m_rendered.telemetry = state.telemetryToText();
+    // the plain form of NordVpnInfo::composeHtml()
+    m_rendered.text = m_rendered.telemetry.isEmpty()
+            ? m_rendered.structureText
+            : QStringLiteral("%1\n%2").arg(m_rendered.structureText, m_rendered.telemetry);
+    m_rendered.toolTipDirty = true;
+}
+
+QString TrayIcon::messageHtml() const
+{
+    return NordVpnInfo::composeHtml(m_rendered.structureHtml, m_rendered.telemetry);
+}
+
+void TrayIcon::updateToolTip()
+{
+    const bool withSparkline = m_history && m_state.status() == NordVpnInfo::Status::Connected;
+    const quint64 historyRevision = withSparkline ? m_history->revision() : 0;
+    if (!m_rendered.toolTipDirty && historyRevision == m_rendered.historyRevision) {
+        return;
+    }
+
+    m_rendered.toolTipDirty = false;
+    m_rendered.historyRevision = historyRevision;
+
+    // always plaintext
+    const QString &sparkline = withSparkline ? m_history->sparkline(SparklineWidth) : QString();
+    setToolTip(sparkline.isEmpty() ? m_rendered.text : QStringLiteral("%1\n%2").arg(m_rendered.text, sparkline));
 }
 
 void TrayIcon::deployDefaults() const
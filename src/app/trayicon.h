@@ -21,6 +21,8 @@
 
 #include <QSystemTrayIcon>
 
+class ConnectionHistory;
+
 class TrayIcon : public QSystemTrayIcon
 {
     Q_OBJECT
@@ -33,9 +35,11 @@ public:
     int duration() const { return m_duration; }
 
     void updateIcon(NordVpnInfo::Status status);
+    void setHistory(const ConnectionHistory *history);
 
 public slots:
     void setState(const NordVpnInfo &state);
+    void setTelemetry(const NordVpnInfo &state);
 
 private:
     struct IconInfo {
@@ -46,7 +50,23 @@ private:
     static QMap<NordVpnInfo::Status, IconInfo> m_allIcons;
     static QMap<NordVpnInfo::Status, QIcon> m_composedIcons;
 
+    // the structural part is formatted once per structure, the telemetry is appended as plain text
+    struct Rendered {
+        bool valid = false;
+        NordVpnInfo state;
+        QString structureHtml;
+        QString structureText;
+        QString telemetry;
+        QString text;
+        quint64 historyRevision = 0;
+        bool toolTipDirty = true;
+    };
+
+    static constexpr int SparklineWidth = 24;
+
     NordVpnInfo m_state;
+    const ConnectionHistory *m_history;
+    Rendered m_rendered;
     bool m_isFirstChange;
     int m_duration;
 
@@ -57,4 +77,9 @@ private:
     static QIcon generateIcon(const NordVpnInfo::Status forStatus);
 
     void deployDefaults() const;
+    void render(const NordVpnInfo &state);
+    QString messageHtml() const;
+    void updateToolTip();
+
+    friend class TestTrayIcon;
 };
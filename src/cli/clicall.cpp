@@ -17,10 +17,14 @@
 
 #include "clicall.h"
 
+#include "app/common.h"
+
 #include <QFile>
+#include <QTimer>
 
 /*static*/ constexpr int CLICall::DefaultTimeoutMSecs;
 
+
 CLICall::CLICall(const QString &path, const QStringList &params, int timeout, QObject *parent)
     : QObject(parent)
     , m_appPath(path)
@@ -30,11 +34,21 @@ CLICall::CLICall(const QString &path, const QStringList &params, int timeout, QO
     , m_errors()
     , m_exitCode(0)
     , m_exitStatus(QProcess::NormalExit)
+    , m_process()
+    , m_deadline(nullptr)
+    , m_origin(Origin::Process)
 {
 }
 
+CLICall::~CLICall()
+{
+    releaseProcess();
+}
+
 QString CLICall::run()
 {
+    m_decoder.reset();
+
     if (m_appPath.isEmpty() || !QFile::exists(m_appPath)) {
         return setResult({}, tr("File [%1] not found").arg(m_appPath));
     }
@@ -48,8 +62,11 @@ QString CLICall::run()
                 m_exitStatus = exitStatus;
             },
             Qt::DirectConnection);
+    connect(
+            &proc, &QProcess::started, this, [this]() { m_timings.spawnMs = m_clock.elapsed(); },
+            Qt::DirectConnection);
 
-    emit starting(m_appPath, m_params);
+    announceStart();
 
     proc.start(m_appPath, m_params, QIODevice::ReadOnly);
 
@@ -57,24 +74,192 @@ QString CLICall::run()
         return setResult({}, tr("Start timeout (%1) reached for [%2]").arg(QString::number(m_timeout), m_appPath));
     }
 
-    auto stripSpinner = [](QString &in) {
-        static const QString spinnerString("-\\|/ \r");
-        while (!in.isEmpty() && spinnerString.contains(in.at(0))) {
-            in.remove(0, 1);
-        }
-        return in;
-    };
-
-    QString result, errors;
+    QString errors;
     while (proc.waitForReadyRead(m_timeout)) {
-        QString in(proc.readAllStandardOutput());
-        result += stripSpinner(in);
+        feedOutput(proc.readAllStandardOutput());
         errors += proc.readAllStandardError();
     }
 
     proc.waitForFinished(m_timeout);
+    emitLines(m_decoder.finish());
+
+    return setResult(m_decoder.result(), errors.trimmed());
+}
+
+bool CLICall::start()
+{
+    if (isRunning()) {
+        WRN << "already running:" << m_appPath << m_params;
+        return false;
+    }
+
+    m_decoder.reset();
+    m_stdErr.clear();
+
+    if (m_appPath.isEmpty() || !QFile::exists(m_appPath)) {
+        setResult({}, tr("File [%1] not found").arg(m_appPath));
+        return false;
+    }
+
+    m_process = new QProcess(this);
+    connect(m_process, &QProcess::readyReadStandardOutput, this, &CLICall::onStdOut);
+    connect(m_process, &QProcess::readyReadStandardError, this, &CLICall::onStdErr);
+    connect(m_process, &QProcess::finished, this, &CLICall::onFinished);
+    connect(m_process, &QProcess::errorOccurred, this, &CLICall::onErrorOccurred);
+    connect(m_process, &QProcess::started, this, [this]() { m_timings.spawnMs = m_clock.elapsed(); });
+
+    if (!m_deadline) {
+        m_deadline = new QTimer(this);
+        m_deadline->setSingleShot(true);
+        connect(m_deadline, &QTimer::timeout, this, &CLICall::onDeadline);
+    }
+
+    announceStart();
+
+    m_deadline->start(m_timeout);
+    m_process->start(m_appPath, m_params, QIODevice::ReadOnly);
+
+    return true;
+}
+
+void CLICall::cancel()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    finish(tr("Cancelled [%1]").arg(m_appPath), -1, QProcess::CrashExit);
+}
+
+bool CLICall::isRunning() const
+{
+    return !m_process.isNull();
+}
+
+void CLICall::onStdOut()
+{
+    if (!m_process) {
+        return;
+    }
+
+    feedOutput(m_process->readAllStandardOutput());
+}
+
+void CLICall::onStdErr()
+{
+    if (!m_process) {
+        return;
+    }
+
+    m_stdErr += m_process->readAllStandardError();
+}
+
+void CLICall::onFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    onStdOut();
+    onStdErr();
+
+    finish(m_stdErr.trimmed(), exitCode, exitStatus);
+}
+
+void CLICall::onErrorOccurred(QProcess::ProcessError error)
+{
+    if (error != QProcess::FailedToStart || !m_process) {
+        return;
+    }
+
+    finish(tr("Failed to start [%1]: %2").arg(m_appPath, m_process->errorString()), -1, QProcess::CrashExit);
+}
+
+void CLICall::onDeadline()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    onStdOut();
+    onStdErr();
+
+    finish(tr("Timeout (%1) reached for [%2]").arg(QString::number(m_timeout), m_appPath), -1, QProcess::CrashExit);
+}
+
+void CLICall::feedOutput(const QByteArray &chunk)
+{
+    if (!chunk.isEmpty() && m_timings.firstByteMs < 0 && m_clock.isValid()) {
+        m_timings.firstByteMs = m_clock.elapsed();
+    }
+
+    emitLines(m_decoder.feed(chunk));
+}
+
+void CLICall::emitLines(const QList<QString> &lines)
+{
+    for (const auto &line : lines) {
+        emit lineReady(line);
+    }
+}
+
+void CLICall::finish(const QString &errors, int exitCode, QProcess::ExitStatus exitStatus)
+{
+    releaseProcess();
+    emitLines(m_decoder.finish());
+
+    const QString &result = m_decoder.result();
+    complete(result, errors, exitCode, exitStatus);
+}
+
+void CLICall::releaseProcess()
+{
+    if (m_deadline) {
+        m_deadline->stop();
+    }
+
+    if (!m_process) {
+        return;
+    }
+
+    QProcess *proc = m_process;
+    m_process.clear();
 
-    return setResult(result.trimmed(), errors.trimmed());
+    proc->disconnect(this);
+    if (proc->state() != QProcess::NotRunning) {
+        proc->kill();
+    }
+    proc->deleteLater();
+}
+
+void CLICall::announceStart()
+{
+    m_timings = {};
+    m_origin = Origin::Process;
+    m_decoder.reset();
+    m_clock.start();
+
+    emit starting(m_appPath, m_params);
+}
+
+void CLICall::complete(const QString &result, const QString &errors, int exitCode, QProcess::ExitStatus exitStatus,
+                       Origin origin)
+{
+    m_origin = origin;
+    m_exitCode = exitCode;
+    m_exitStatus = exitStatus;
+    setResult(result, errors);
+}
+
+QString CLICall::appPath() const
+{
+    return m_appPath;
+}
+
+QStringList CLICall::params() const
+{
+    return m_params;
+}
+
+int CLICall::timeout() const
+{
+    return m_timeout;
 }
 
 QString CLICall::result() const
@@ -92,6 +277,12 @@ QString CLICall::setResult(const QString &result, const QString &errors)
         m_result = result;
     }
 
+    if (m_clock.isValid()) {
+        m_timings.totalMs = m_clock.elapsed();
+    }
+    // a shared result was read by another call
+    m_timings.bytesRead = m_origin == Origin::Process ? m_decoder.bytesFed() : 0;
+
     emit ready(m_result);
 
     return m_result;
@@ -116,3 +307,13 @@ bool CLICall::success() const
 {
     return exitCode() == 0 && exitStatus() == QProcess::NormalExit;
 }
+
+CLICall::Timings CLICall::timings() const
+{
+    return m_timings;
+}
+
+CLICall::Origin CLICall::origin() const
+{
+    return m_origin;
+}
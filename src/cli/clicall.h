@@ -17,10 +17,16 @@
 
 #pragma once
 
+#include "cli/clioutputdecoder.h"
+
+#include <QElapsedTimer>
 #include <QObject>
+#include <QPointer>
 #include <QProcess>
 #include <QStringList>
 
+class QTimer;
+
 class CLICall : public QObject
 {
     Q_OBJECT
@@ -28,10 +34,37 @@ class CLICall : public QObject
 public:
     static constexpr int DefaultTimeoutMSecs = 30000;
 
+    struct Timings {
+        qint64 spawnMs = -1;
+        qint64 firstByteMs = -1;
+        qint64 totalMs = -1;
+        qint64 bytesRead = 0;
+    };
+
+    // where the result came from: a process of its own, the result cache, or another in-flight call
+    enum class Origin
+    {
+        Process,
+        Cache,
+        Coalesced,
+    };
+
     explicit CLICall(const QString &path, const QStringList &params, int timeout, QObject *parent = {});
-    ~CLICall() = default;
+    ~CLICall();
 
     QString run();
+
+    bool start();
+    void cancel();
+    bool isRunning() const;
+    void announceStart();
+    void complete(const QString &result, const QString &errors, int exitCode = 0,
+                  QProcess::ExitStatus exitStatus = QProcess::NormalExit, Origin origin = Origin::Process);
+
+    QString appPath() const;
+    QStringList params() const;
+    int timeout() const;
+
     QString result() const;
     QString errors() const;
 
@@ -39,8 +72,12 @@ public:
     QProcess::ExitStatus exitStatus() const;
     bool success() const;
 
+    Timings timings() const;
+    Origin origin() const;
+
 signals:
     void starting(const QString &myApp, const QStringList &myArgs);
+    void lineReady(const QString &line);
     void ready(const QString &result);
 
 protected:
@@ -53,7 +90,27 @@ protected:
 
     QString setResult(const QString &result, const QString &errors);
 
+private slots:
+    void onStdOut();
+    void onStdErr();
+    void onFinished(int exitCode, QProcess::ExitStatus exitStatus);
+    void onErrorOccurred(QProcess::ProcessError error);
+    void onDeadline();
+
 private:
+    QPointer<QProcess> m_process;
+    QTimer *m_deadline;
+    CLIOutputDecoder m_decoder;
+    QString m_stdErr;
+    QElapsedTimer m_clock;
+    Timings m_timings;
+    Origin m_origin;
+
+    void feedOutput(const QByteArray &chunk);
+    void emitLines(const QList<QString> &lines);
+    void finish(const QString &errors, int exitCode, QProcess::ExitStatus exitStatus);
+    void releaseProcess();
+
     CLICall(QObject *parent = {}) = delete;
 
     Q_DISABLE_COPY_MOVE(CLICall);
@@ -18,47 +18,176 @@
 #include "clicaller.h"
 
 #include "actions/action.h"
-
-#include <QRunnable>
-#include <QThreadPool>
-
-class RunCallTask : public QRunnable
-{
-public:
-    RunCallTask(CLICall *call)
-        : m_call(call)
-    {
-    }
-
-private:
-    CLICall *m_call;
-
-    void run() override { m_call->run(); }
-};
+#include "cli/cliresultcache.h"
 
 CLICaller::CLICaller(QObject *parent)
     : QObject(parent)
+    , m_executor(new CLIExecutor(this))
 {
 }
 
-bool CLICaller::performAction(Action *action)
+bool CLICaller::performAction(Action *action, CLIExecutor::Lane lane)
 {
     if (!action)
         return false;
 
     if (auto call = action->createRequest()) {
-        runQuery(call);
+        runQuery(call, lane);
         return true;
     }
 
     return false;
 }
 
-void CLICaller::runQuery(CLICall *call)
+CLIExecutor *CLICaller::executor() const
+{
+    return m_executor;
+}
+
+CLIResultCache *CLICaller::cache() const
+{
+    return m_cache;
+}
+
+void CLICaller::setCache(CLIResultCache *cache)
+{
+    if (cache == m_cache)
+        return;
+
+    if (m_cache)
+        m_cache->deleteLater();
+
+    m_cache = cache;
+
+    if (m_cache)
+        m_cache->setParent(this);
+}
+
+CLICaller::Stats CLICaller::stats() const
+{
+    return m_stats;
+}
+
+/*static*/ QString CLICaller::requestKey(const CLICall *call)
+{
+    if (!call)
+        return {};
+
+    return QStringList { call->appPath(), call->params().join(QChar(0x1f)) }.join(QChar(0x1e));
+}
+
+/*static*/ bool CLICaller::isReadOnly(const CLICall *call)
+{
+    // Only queries that do not change the daemon state may share a single run,
+    // commands like connect, disconnect or set must reach the CLI every time.
+    static const QStringList readOnlyCommands {
+        "status", "settings", "account", "countries", "cities", "groups", "version",
+    };
+
+    return call && !call->params().isEmpty() && readOnlyCommands.contains(call->params().first());
+}
+
+void CLICaller::runQuery(CLICall *call, CLIExecutor::Lane lane)
 {
     if (!call)
         return;
 
-    RunCallTask *task = new RunCallTask(call);
-    QThreadPool::globalInstance()->start(task);
+    ++m_stats.requested;
+
+    if (completeFromCache(call))
+        return;
+
+    coalesce(call, lane);
+}
+
+bool CLICaller::completeFromCache(CLICall *call)
+{
+    CLIResultCache::Entry entry;
+    if (!m_cache || !m_cache->lookup(call, &entry))
+        return false;
+
+    QPointer<CLICall> guard(call);
+    QMetaObject::invokeMethod(
+            this,
+            [guard, entry]() {
+                if (guard) {
+                    guard->announceStart();
+                    guard->complete(entry.result, entry.errors, entry.exitCode, QProcess::NormalExit,
+                                    CLICall::Origin::Cache);
+                }
+            },
+            Qt::QueuedConnection);
+
+    return true;
+}
+
+void CLICaller::coalesce(CLICall *call, CLIExecutor::Lane lane)
+{
+    if (!isReadOnly(call)) {
+        execute(call, lane);
+        return;
+    }
+
+    const QString &key = requestKey(call);
+
+    QList<QPointer<CLICall>> followers;
+    auto it = m_inFlight.find(key);
+    if (it != m_inFlight.end()) {
+        if (it->leader) {
+            ++m_stats.coalesced;
+            it->followers.append(call);
+            call->announceStart();
+            return;
+        }
+
+        // the leader is gone but its followers are still waiting, the new call takes them over
+        followers = it->followers;
+        m_inFlight.erase(it);
+    }
+
+    m_inFlight.insert(key, { call, lane, followers });
+    connect(call, &CLICall::ready, this, [this, key, call]() { onLeaderReady(key, call); });
+    connect(call, &QObject::destroyed, this, [this, key](QObject *obj) { onLeaderDestroyed(key, obj); });
+
+    execute(call, lane);
+}
+
+void CLICaller::onLeaderReady(const QString &key, CLICall *leader)
+{
+    const auto it = m_inFlight.constFind(key);
+    if (it == m_inFlight.cend() || it->leader != leader)
+        return;
+
+    const QList<QPointer<CLICall>> followers = it->followers;
+    m_inFlight.erase(it);
+
+    if (m_cache)
+        m_cache->store(leader);
+
+    for (const auto &follower : followers) {
+        if (follower)
+            follower->complete(leader->result(), leader->errors(), leader->exitCode(), leader->exitStatus(),
+                               CLICall::Origin::Coalesced);
+    }
+}
+
+void CLICaller::onLeaderDestroyed(const QString &key, QObject *leader)
+{
+    const auto it = m_inFlight.constFind(key);
+    if (it == m_inFlight.cend() || (it->leader && it->leader != leader))
+        return;
+
+    const QList<QPointer<CLICall>> followers = it->followers;
+    const CLIExecutor::Lane lane = it->lane;
+    m_inFlight.erase(it);
+
+    for (const auto &follower : followers) {
+        if (follower)
+            coalesce(follower, lane);
+    }
+}
+
+void CLICaller::execute(CLICall *call, CLIExecutor::Lane lane)
+{
+    m_executor->enqueue(call, lane);
 }
@@ -18,20 +18,52 @@
 #pragma once
 
 #include "cli/clicall.h"
+#include "cli/cliexecutor.h"
 
+#include <QHash>
 #include <QObject>
+#include <QPointer>
 
 class Action;
+class CLIResultCache;
 class CLICaller : public QObject
 {
     Q_OBJECT
 public:
+    struct Stats {
+        int requested = 0;
+        int coalesced = 0;
+    };
+
     explicit CLICaller(QObject *parent = {});
 
-    bool performAction(Action *action);
+    bool performAction(Action *action, CLIExecutor::Lane lane = CLIExecutor::Lane::Interactive);
+
+    CLIExecutor *executor() const;
+
+    CLIResultCache *cache() const;
+    void setCache(CLIResultCache *cache);
 
-signals:
+    Stats stats() const;
+    static QString requestKey(const CLICall *call);
+    static bool isReadOnly(const CLICall *call);
 
 private:
-    void runQuery(CLICall *call);
+    struct InFlight {
+        QPointer<CLICall> leader;
+        CLIExecutor::Lane lane;
+        QList<QPointer<CLICall>> followers;
+    };
+
+    CLIExecutor *m_executor;
+    QPointer<CLIResultCache> m_cache;
+    QHash<QString, InFlight> m_inFlight;
+    Stats m_stats;
+
+    void runQuery(CLICall *call, CLIExecutor::Lane lane);
+    bool completeFromCache(CLICall *call);
+    void coalesce(CLICall *call, CLIExecutor::Lane lane);
+    void execute(CLICall *call, CLIExecutor::Lane lane);
+    void onLeaderReady(const QString &key, CLICall *leader);
+    void onLeaderDestroyed(const QString &key, QObject *leader);
 };
@@ -0,0 +1,176 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "cliexecutor.h"
+
+#include "app/common.h"
+#include "cli/clicall.h"
+
+CLIExecutor::CLIExecutor(QObject *parent)
+    : QObject(parent)
+    , m_dispatching(false)
+{
+    for (int i = 0; i < static_cast<int>(Lane::Count); ++i) {
+        const Lane lane = static_cast<Lane>(i);
+        state(lane).stats.limit = defaultLimit(lane);
+    }
+}
+
+/*static*/ int CLIExecutor::defaultLimit(Lane lane)
+{
+    switch (lane) {
+    case Lane::Interactive:
+        return 4;
+    case Lane::Polling:
+        return 1;
+    case Lane::Bulk:
+        return 4;
+    default:
+        break;
+    }
+
+    return 1;
+}
+
+CLIExecutor::LaneState &CLIExecutor::state(Lane lane)
+{
+    return m_lanes[static_cast<size_t>(lane)];
+}
+
+const CLIExecutor::LaneState &CLIExecutor::state(Lane lane) const
+{
+    return m_lanes[static_cast<size_t>(lane)];
+}
+
+void CLIExecutor::enqueue(CLICall *call, Lane lane)
+{
+    if (!call || lane == Lane::Count)
+        return;
+
+    LaneState &laneState = state(lane);
+
+    Pending pending { call, {} };
+    pending.waiting.start();
+    laneState.queue.enqueue(pending);
+
+    laneState.stats.queued = laneState.queue.size();
+    laneState.stats.maxQueued = qMax(laneState.stats.maxQueued, laneState.stats.queued);
+
+    dispatch();
+}
+
+int CLIExecutor::limit(Lane lane) const
+{
+    return state(lane).stats.limit;
+}
+
+void CLIExecutor::setLimit(Lane lane, int limit)
+{
+    if (lane == Lane::Count)
+        return;
+
+    LaneStats &stats = state(lane).stats;
+    const int newLimit = qMax(1, limit);
+    if (newLimit != stats.limit) {
+        stats.limit = newLimit;
+        dispatch();
+    }
+}
+
+CLIExecutor::LaneStats CLIExecutor::stats(Lane lane) const
+{
+    return state(lane).stats;
+}
+
+void CLIExecutor::dispatch()
+{
+    if (m_dispatching)
+        return;
+
+    m_dispatching = true;
+
+    bool started(true);
+    while (started) {
+        started = false;
+        for (int i = 0; i < static_cast<int>(Lane::Count); ++i) {
+            const Lane lane = static_cast<Lane>(i);
+            LaneState &laneState = state(lane);
+            LaneStats &stats = laneState.stats;
+
+            while (stats.inFlight < stats.limit && !laneState.queue.isEmpty()) {
+                const Pending pending = laneState.queue.dequeue();
+                stats.queued = laneState.queue.size();
+
+                CLICall *call = pending.call;
+                if (!call)
+                    continue;
+
+                if (m_running.contains(call)) {
+                    WRN << "already dispatched:" << call->appPath() << call->params();
+                    continue;
+                }
+
+                const qint64 waitMs = pending.waiting.elapsed();
+                stats.totalWaitMs += waitMs;
+                stats.maxWaitMs = qMax(stats.maxWaitMs, waitMs);
+                ++stats.started;
+                ++stats.inFlight;
+
+                m_running.insert(call, lane);
+                connect(call, &CLICall::ready, this, [this, call]() { onCallDone(call); });
+                connect(call, &QObject::destroyed, this, [this](QObject *obj) { onCallDone(obj); });
+
+                if (call->start()) {
+                    started = true;
+                } else {
+                    releaseFailed(call);
+                }
+            }
+        }
+    }
+
+    m_dispatching = false;
+}
+
+void CLIExecutor::releaseFailed(CLICall *call)
+{
+    // a failed start may have already reported through ready()
+    const auto it = m_running.constFind(call);
+    if (it == m_running.cend())
+        return;
+
+    LaneStats &stats = state(it.value()).stats;
+    m_running.erase(it);
+    --stats.inFlight;
+
+    // a call started elsewhere reports on its own, anything else would never do
+    if (!call->isRunning())
+        call->complete({}, tr("Failed to start [%1]").arg(call->appPath()), -1, QProcess::CrashExit);
+}
+
+void CLIExecutor::onCallDone(const QObject *call)
+{
+    const auto it = m_running.constFind(call);
+    if (it == m_running.cend())
+        return;
+
+    LaneStats &stats = state(it.value()).stats;
+    m_running.erase(it);
+    --stats.inFlight;
+
+    dispatch();
+}
@@ -0,0 +1,84 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <array>
+
+class CLICall;
+class CLIExecutor : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Lane
+    {
+        Interactive = 0,
+        Polling,
+        Bulk,
+
+        Count
+    };
+    Q_ENUM(Lane);
+
+    struct LaneStats {
+        int limit = 1;
+        int queued = 0;
+        int inFlight = 0;
+        int maxQueued = 0;
+        int started = 0;
+        qint64 totalWaitMs = 0;
+        qint64 maxWaitMs = 0;
+    };
+
+    explicit CLIExecutor(QObject *parent = {});
+
+    void enqueue(CLICall *call, Lane lane);
+
+    int limit(Lane lane) const;
+    void setLimit(Lane lane, int limit);
+
+    LaneStats stats(Lane lane) const;
+
+    static int defaultLimit(Lane lane);
+
+private:
+    struct Pending {
+        QPointer<CLICall> call;
+        QElapsedTimer waiting;
+    };
+
+    struct LaneState {
+        QQueue<Pending> queue;
+        LaneStats stats;
+    };
+
+    std::array<LaneState, static_cast<size_t>(Lane::Count)> m_lanes;
+    QHash<const QObject *, Lane> m_running;
+    bool m_dispatching;
+
+    LaneState &state(Lane lane);
+    const LaneState &state(Lane lane) const;
+
+    void dispatch();
+    void releaseFailed(CLICall *call);
+    void onCallDone(const QObject *call);
+};
@@ -0,0 +1,217 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "climetrics.h"
+
+#include "app/common.h"
+#include "settings/settingsmanager.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <algorithm>
+
+void CLIMetrics::Histogram::add(qint64 valueMs)
+{
+    if (valueMs < 0) {
+        return;
+    }
+
+    const auto bound = std::lower_bound(UpperBoundsMs.cbegin(), UpperBoundsMs.cend(), valueMs);
+    ++m_buckets[std::distance(UpperBoundsMs.cbegin(), bound)];
+
+    m_min = m_count ? qMin(m_min, valueMs) : valueMs;
+    m_max = m_count ? qMax(m_max, valueMs) : valueMs;
+    m_sum += valueMs;
+    ++m_count;
+}
+
+quint64 CLIMetrics::Histogram::count() const
+{
+    return m_count;
+}
+
+qint64 CLIMetrics::Histogram::min() const
+{
+    return m_min;
+}
+
+qint64 CLIMetrics::Histogram::max() const
+{
+    return m_max;
+}
+
+double CLIMetrics::Histogram::mean() const
+{
+    return m_count ? static_cast<double>(m_sum) / m_count : 0.;
+}
+
+qint64 CLIMetrics::Histogram::percentile(double fraction) const
+{
+    if (!m_count) {
+        return 0;
+    }
+
+    const quint64 rank = qMax<quint64>(1, static_cast<quint64>(fraction * m_count + 0.5));
+    quint64 seen(0);
+    for (size_t i = 0; i < BucketsCount; ++i) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            return i < UpperBoundsMs.size() ? qMin(UpperBoundsMs[i], m_max) : m_max;
+        }
+    }
+
+    return m_max;
+}
+
+const std::array<quint64, CLIMetrics::Histogram::BucketsCount> &CLIMetrics::Histogram::buckets() const
+{
+    return m_buckets;
+}
+
+QJsonObject CLIMetrics::Histogram::toJson() const
+{
+    QJsonArray jBuckets;
+    for (size_t i = 0; i < BucketsCount; ++i) {
+        jBuckets.append(QJsonObject {
+                { "le", i < UpperBoundsMs.size() ? QJsonValue(UpperBoundsMs[i]) : QJsonValue("inf") },
+                { "count", static_cast<qint64>(m_buckets[i]) },
+        });
+    }
+
+    return {
+        { "count", static_cast<qint64>(m_count) },
+        { "min", m_min },
+        { "max", m_max },
+        { "mean", mean() },
+        { "p50", percentile(0.5) },
+        { "p95", percentile(0.95) },
+        { "buckets", jBuckets },
+    };
+}
+
+CLIMetrics::CLIMetrics(QObject *parent)
+    : QObject(parent)
+{
+}
+
+/*static*/ CLIMetrics *CLIMetrics::instance()
+{
+    static CLIMetrics *metrics = new CLIMetrics(qApp);
+    return metrics;
+}
+
+void CLIMetrics::record(const QUuid &id, const QString &title, const Sample &sample)
+{
+    Entry &entry = m_entries[id];
+    entry.title = title;
+    ++entry.calls;
+    if (!sample.ok) {
+        ++entry.failures;
+    }
+    if (sample.exitStatus != QProcess::NormalExit) {
+        ++entry.crashes;
+    }
+    entry.bytesRead += sample.bytesRead;
+    entry.spawn.add(sample.spawnMs);
+    entry.firstByte.add(sample.firstByteMs);
+    entry.total.add(sample.totalMs);
+
+    emit updated(id);
+}
+
+void CLIMetrics::recordCacheHit(const QUuid &id, const QString &title)
+{
+    Entry &entry = m_entries[id];
+    entry.title = title;
+    ++entry.cacheHits;
+
+    emit updated(id);
+}
+
+void CLIMetrics::recordCoalesced(const QUuid &id, const QString &title)
+{
+    Entry &entry = m_entries[id];
+    entry.title = title;
+    ++entry.coalesced;
+
+    emit updated(id);
+}
+
+QList<QUuid> CLIMetrics::ids() const
+{
+    return m_entries.keys();
+}
+
+CLIMetrics::Entry CLIMetrics::entry(const QUuid &id) const
+{
+    return m_entries.value(id);
+}
+
+void CLIMetrics::clear()
+{
+    m_entries.clear();
+    emit updated({});
+}
+
+QJsonObject CLIMetrics::toJson() const
+{
+    QJsonArray jActions;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        jActions.append(QJsonObject {
+                { "id", it.key().toString(QUuid::WithoutBraces) },
+                { "title", it->title },
+                { "calls", static_cast<qint64>(it->calls) },
+                { "failures", static_cast<qint64>(it->failures) },
+                { "crashes", static_cast<qint64>(it->crashes) },
+                { "bytesRead", static_cast<qint64>(it->bytesRead) },
+                { "cacheHits", static_cast<qint64>(it->cacheHits) },
+                { "coalesced", static_cast<qint64>(it->coalesced) },
+                { "spawnMs", it->spawn.toJson() },
+                { "firstByteMs", it->firstByte.toJson() },
+                { "totalMs", it->total.toJson() },
+        });
+    }
+
+    return {
+        { "timestamp", QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs) },
+        { "actions", jActions },
+    };
+}
+
+/*static*/ QString CLIMetrics::defaultDumpPath()
+{
+    return QString("%1/cli_metrics.json").arg(SettingsManager::dirPath());
+}
+
+bool CLIMetrics::dump(const QString &filePath) const
+{
+    QFile out(utils::ensureDirExists(filePath));
+    if (!out.open(QFile::WriteOnly | QFile::Text | QFile::Truncate)) {
+        WRN << "failed opening file" << filePath << out.errorString();
+        return false;
+    }
+
+    if (-1 == out.write(QJsonDocument(toJson()).toJson())) {
+        WRN << "error during file write:" << out.errorString();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,101 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QJsonObject>
+#include <QObject>
+#include <QProcess>
+#include <QUuid>
+#include <array>
+
+class CLIMetrics : public QObject
+{
+    Q_OBJECT
+public:
+    struct Sample {
+        qint64 spawnMs = -1;
+        qint64 firstByteMs = -1;
+        qint64 totalMs = -1;
+        qint64 bytesRead = 0;
+        int exitCode = 0;
+        QProcess::ExitStatus exitStatus = QProcess::NormalExit;
+        bool ok = true;
+    };
+
+    class Histogram
+    {
+    public:
+        static constexpr std::array<qint64, 14> UpperBoundsMs { 1,   2,    5,    10,   20,    50,    100,
+                                                                200, 500, 1000, 2000, 5000, 10000, 30000 };
+        static constexpr size_t BucketsCount = UpperBoundsMs.size() + 1;
+
+        void add(qint64 valueMs);
+
+        quint64 count() const;
+        qint64 min() const;
+        qint64 max() const;
+        double mean() const;
+        qint64 percentile(double fraction) const;
+
+        const std::array<quint64, BucketsCount> &buckets() const;
+        QJsonObject toJson() const;
+
+    private:
+        std::array<quint64, BucketsCount> m_buckets {};
+        quint64 m_count = 0;
+        qint64 m_sum = 0;
+        qint64 m_min = 0;
+        qint64 m_max = 0;
+    };
+
+    struct Entry {
+        QString title;
+        quint64 calls = 0;
+        quint64 failures = 0;
+        quint64 crashes = 0;
+        quint64 bytesRead = 0;
+        quint64 cacheHits = 0; // served without a process, not in the calls and histograms
+        quint64 coalesced = 0;
+        Histogram spawn;
+        Histogram firstByte;
+        Histogram total;
+    };
+
+    static CLIMetrics *instance();
+
+    void record(const QUuid &id, const QString &title, const Sample &sample);
+    void recordCacheHit(const QUuid &id, const QString &title);
+    void recordCoalesced(const QUuid &id, const QString &title);
+
+    QList<QUuid> ids() const;
+    Entry entry(const QUuid &id) const;
+    void clear();
+
+    QJsonObject toJson() const;
+    bool dump(const QString &filePath) const;
+    static QString defaultDumpPath();
+
+signals:
+    void updated(const QUuid &id);
+
+private:
+    explicit CLIMetrics(QObject *parent = {});
+
+    QHash<QUuid, Entry> m_entries;
+};
@@ -0,0 +1,125 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "clioutputdecoder.h"
+
+static constexpr char Esc = 0x1b;
+
+CLIOutputDecoder::CLIOutputDecoder()
+    : m_state(State::Text)
+    , m_line()
+    , m_output()
+    , m_bytesFed(0)
+{
+}
+
+// The spinner redraws a single line: "\r-\r  \r\\\r...". A carriage return not followed by
+// a line feed discards what has been printed on the current line, so only the text after
+// the last frame survives, while the line content itself (indents, leading dashes) is kept.
+QList<QString> CLIOutputDecoder::feed(QByteArrayView chunk)
+{
+    QList<QString> lines;
+    m_bytesFed += chunk.size();
+
+    for (const char c : chunk) {
+        switch (m_state) {
+        case State::CarriageReturn:
+            m_state = State::Text;
+            if (c != '\n') {
+                m_line.clear();
+            }
+            [[fallthrough]];
+        case State::Text:
+            switch (c) {
+            case '\n':
+                takeLine(lines);
+                break;
+            case '\r':
+                m_state = State::CarriageReturn;
+                break;
+            case Esc:
+                m_state = State::Escape;
+                break;
+            default:
+                m_line.append(c);
+                break;
+            }
+            break;
+        case State::Escape:
+            m_state = c == '[' ? State::Csi : State::Text;
+            break;
+        case State::Csi:
+            if (c >= 0x40 && c <= 0x7e) {
+                m_state = State::Text;
+            }
+            break;
+        }
+    }
+
+    return lines;
+}
+
+QList<QString> CLIOutputDecoder::finish()
+{
+    if (m_state == State::CarriageReturn) {
+        m_line.clear();
+    }
+
+    QList<QString> lines;
+    if (!m_line.isEmpty()) {
+        takeLine(lines);
+    }
+    m_state = State::Text;
+    return lines;
+}
+
+void CLIOutputDecoder::takeLine(QList<QString> &lines)
+{
+    if (!m_output.isEmpty()) {
+        m_output.append('\n');
+    }
+    m_output.append(m_line);
+
+    lines.append(QString::fromUtf8(m_line));
+    m_line.clear();
+}
+
+QString CLIOutputDecoder::result() const
+{
+    QByteArray out(m_output);
+    if (!m_line.isEmpty() && m_state != State::CarriageReturn) {
+        if (!out.isEmpty()) {
+            out.append('\n');
+        }
+        out.append(m_line);
+    }
+
+    return QString::fromUtf8(out).trimmed();
+}
+
+qsizetype CLIOutputDecoder::bytesFed() const
+{
+    return m_bytesFed;
+}
+
+void CLIOutputDecoder::reset()
+{
+    m_state = State::Text;
+    m_line.clear();
+    m_output.clear();
+    m_bytesFed = 0;
+}
@@ -0,0 +1,53 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QList>
+#include <QString>
+
+class CLIOutputDecoder
+{
+public:
+    CLIOutputDecoder();
+
+    QList<QString> feed(QByteArrayView chunk);
+    QList<QString> finish();
+
+    QString result() const;
+    qsizetype bytesFed() const;
+
+    void reset();
+
+private:
+    enum class State
+    {
+        Text,
+        CarriageReturn,
+        Escape,
+        Csi,
+    };
+
+    State m_state;
+    QByteArray m_line;
+    QByteArray m_output;
+    qsizetype m_bytesFed;
+
+    void takeLine(QList<QString> &lines);
+};
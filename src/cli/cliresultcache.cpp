@@ -0,0 +1,185 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "cliresultcache.h"
+
+#include "app/common.h"
+#include "app/jsonfilestore.h"
+#include "cli/clicall.h"
+#include "cli/clicaller.h"
+
+#include <QJsonObject>
+#include <QTimeZone>
+
+namespace JsonConsts {
+static const QLatin1String Key { "key" };
+static const QLatin1String Result { "result" };
+static const QLatin1String Errors { "errors" };
+static const QLatin1String ExitCode { "exitCode" };
+static const QLatin1String Stored { "stored" };
+};
+
+static constexpr int CacheFormatVersion = 1;
+
+CLIResultCache::CLIResultCache(const QString &filePath, QObject *parent)
+    : QObject(parent)
+    , m_store(new JsonFileStore(filePath, CacheFormatVersion, this))
+{
+    m_store->setWriter([this]() { return toJson(); });
+}
+
+CLIResultCache::~CLIResultCache()
+{
+    m_store->flush();
+}
+
+QString CLIResultCache::filePath() const
+{
+    return m_store->filePath();
+}
+
+int CLIResultCache::ttl(const QString &command) const
+{
+    return m_ttls.value(command, 0);
+}
+
+void CLIResultCache::setTtl(const QString &command, int secs)
+{
+    if (secs > 0) {
+        m_ttls.insert(command, secs);
+    } else {
+        m_ttls.remove(command);
+    }
+}
+
+/*static*/ QString CLIResultCache::command(const CLICall *call)
+{
+    if (!call || call->params().isEmpty()) {
+        return {};
+    }
+
+    return call->params().first();
+}
+
+bool CLIResultCache::isCacheable(const CLICall *call) const
+{
+    return ttl(command(call)) > 0;
+}
+
+bool CLIResultCache::isExpired(const QString &key, const Entry &entry) const
+{
+    const QString &cmd = key.section(QChar(0x1e), 1).section(QChar(0x1f), 0, 0);
+    const int secs = ttl(cmd);
+    return secs <= 0 || !entry.stored.isValid() || entry.stored.secsTo(QDateTime::currentDateTimeUtc()) >= secs;
+}
+
+bool CLIResultCache::lookup(const CLICall *call, Entry *entry)
+{
+    if (!isCacheable(call)) {
+        return false;
+    }
+
+    const QString &key = CLICaller::requestKey(call);
+    const auto it = m_entries.constFind(key);
+    if (it == m_entries.cend() || isExpired(key, it.value())) {
+        ++m_stats.misses;
+        return false;
+    }
+
+    ++m_stats.hits;
+    if (entry) {
+        *entry = it.value();
+    }
+    return true;
+}
+
+void CLIResultCache::store(const CLICall *call)
+{
+    if (!call || !call->success() || !isCacheable(call)) {
+        return;
+    }
+
+    m_entries.insert(CLICaller::requestKey(call),
+                     { call->result(), call->errors(), call->exitCode(), QDateTime::currentDateTimeUtc() });
+    ++m_stats.stores;
+
+    m_store->scheduleSave();
+}
+
+int CLIResultCache::size() const
+{
+    return m_entries.size();
+}
+
+CLIResultCache::Stats CLIResultCache::stats() const
+{
+    return m_stats;
+}
+
+void CLIResultCache::invalidate()
+{
+    LOG << "dropping" << m_entries.size() << "entries";
+
+    m_entries.clear();
+    m_store->discard();
+}
+
+void CLIResultCache::load()
+{
+    // expired entries are kept: the TTLs may be not configured yet, lookup() checks them anyway
+    const QJsonArray &jArr = m_store->read();
+    for (const auto &jVal : jArr) {
+        const QJsonObject &jObj = jVal.toObject();
+        const QString &key = jObj.value(JsonConsts::Key).toString();
+        const Entry entry {
+            jObj.value(JsonConsts::Result).toString(),
+            jObj.value(JsonConsts::Errors).toString(),
+            jObj.value(JsonConsts::ExitCode).toInt(),
+            QDateTime::fromMSecsSinceEpoch(jObj.value(JsonConsts::Stored).toInteger(), QTimeZone::UTC),
+        };
+
+        if (!key.isEmpty()) {
+            m_entries.insert(key, entry);
+        }
+    }
+
+    LOG << "loaded" << m_entries.size() << "entries from" << filePath();
+}
+
+void CLIResultCache::save()
+{
+    m_store->save();
+}
+
+QJsonArray CLIResultCache::toJson() const
+{
+    QJsonArray jArr;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        if (isExpired(it.key(), it.value())) {
+            continue;
+        }
+
+        jArr.append(QJsonObject {
+                { JsonConsts::Key, it.key() },
+                { JsonConsts::Result, it->result },
+                { JsonConsts::Errors, it->errors },
+                { JsonConsts::ExitCode, it->exitCode },
+                { JsonConsts::Stored, it->stored.toMSecsSinceEpoch() },
+        });
+    }
+    return jArr;
+}
@@ -0,0 +1,81 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QJsonArray>
+#include <QObject>
+#include <QProcess>
+
+class CLICall;
+class JsonFileStore;
+
+// Keeps the output of the slow read-only queries (groups, countries, cities) between runs.
+// The owner loads the file once at startup; entries are written back a second after a change.
+// Each command (the first CLI param) has its own TTL, shared by all of its arguments:
+// "cities Germany" and "cities France" both live for the TTL of "cities".
+// The TTL is checked on lookup, so changing it applies to the loaded entries as well.
+// A command without a TTL is not cached. invalidate() drops everything, e.g. on an explicit reload.
+class CLIResultCache : public QObject
+{
+    Q_OBJECT
+public:
+    struct Entry {
+        QString result;
+        QString errors;
+        int exitCode = 0;
+        QDateTime stored;
+    };
+
+    struct Stats {
+        int hits = 0;
+        int misses = 0;
+        int stores = 0;
+    };
+
+    explicit CLIResultCache(const QString &filePath, QObject *parent = {});
+    ~CLIResultCache() override;
+
+    QString filePath() const;
+
+    int ttl(const QString &command) const;
+    void setTtl(const QString &command, int secs);
+
+    bool isCacheable(const CLICall *call) const;
+    bool lookup(const CLICall *call, Entry *entry);
+    void store(const CLICall *call);
+
+    int size() const;
+    Stats stats() const;
+
+public slots:
+    void invalidate();
+    void load();
+    void save();
+
+private:
+    JsonFileStore *m_store;
+    QHash<QString, int> m_ttls;
+    QHash<QString, Entry> m_entries;
+    Stats m_stats;
+
+    static QString command(const CLICall *call);
+    bool isExpired(const QString &key, const Entry &entry) const;
+    QJsonArray toJson() const;
+};
@@ -0,0 +1,346 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+This application is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This application is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "citiesdatabase.h"
+
+#include "app/common.h"
+#include "geo/placenames.h"
+
+#include <QResource>
+#include <QStringDecoder>
+#include <QVarLengthArray>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// The closest key within the fuzzy limit, if it stands out: a tie or a runner-up just one edit further
+// is ambiguous and left to the online geocoding.
+// The UTF-8 keys are decoded into one reused buffer, a miss doesn't allocate per key.
+template<typename Entry, typename KeyOf>
+const Entry *closestUnique(const QString &key, const Entry *begin, const Entry *end, KeyOf keyOf)
+{
+    const int limit = PlaceNames::fuzzyLimit(key.size());
+    QStringDecoder decoder(QStringDecoder::Utf8, QStringDecoder::Flag::Stateless);
+    QVarLengthArray<QChar, 64> buffer;
+
+    const Entry *closest(nullptr);
+    int closestDistance = limit + 1;
+    int runnerUpDistance = limit + 1;
+    for (const Entry *entry = begin; entry != end; ++entry) {
+        const QByteArrayView utf8 = keyOf(*entry);
+        if (utf8.size() < key.size() - limit) {
+            continue; // never fewer bytes than UTF-16 units, too short for a match
+        }
+
+        buffer.resize(utf8.size());
+        const QChar *decodedEnd = decoder.appendToBuffer(buffer.data(), utf8);
+        const QStringView candidate(buffer.data(), decodedEnd - buffer.data());
+
+        const int distance = PlaceNames::distance(key, candidate, limit);
+        if (distance < closestDistance) {
+            runnerUpDistance = closestDistance;
+            closest = entry;
+            closestDistance = distance;
+        } else if (distance < runnerUpDistance) {
+            runnerUpDistance = distance;
+        }
+    }
+
+    const bool ambiguous = runnerUpDistance <= limit && runnerUpDistance <= closestDistance + 1;
+    return ambiguous ? nullptr : closest;
+}
+
+} // namespace
+
+CitiesDatabase::~CitiesDatabase()
+{
+    close();
+}
+
+/*static*/ const CitiesDatabase &CitiesDatabase::builtin()
+{
+    static CitiesDatabase database;
+    static const bool opened = database.open(BuiltinPath);
+    Q_UNUSED(opened);
+    return database;
+}
+
+bool CitiesDatabase::open(const QString &path)
+{
+    close();
+
+    if (path.startsWith(QLatin1Char(':'))) {
+        const QResource resource(path);
+        if (!resource.isValid()) {
+            WRN << QString("Places database resource '%1' not found").arg(path);
+            return false;
+        }
+
+        if (resource.compressionAlgorithm() == QResource::NoCompression) {
+            return attach(resource.data(), resource.size());
+        }
+
+        m_owned = resource.uncompressedData();
+        return attach(reinterpret_cast<const uchar *>(m_owned.constData()), m_owned.size());
+    }
+
+    m_file.setFileName(path);
+    if (!m_file.open(QFile::ReadOnly)) {
+        WRN << QString("Places database file '%1' not found: %2").arg(path, m_file.errorString());
+        return false;
+    }
+
+    if (const uchar *mapped = m_file.map(0, m_file.size())) {
+        return attach(mapped, m_file.size());
+    }
+
+    m_owned = m_file.readAll();
+    m_file.close();
+    return attach(reinterpret_cast<const uchar *>(m_owned.constData()), m_owned.size());
+}
+
+bool CitiesDatabase::openData(const QByteArray &data)
+{
+    close();
+
+    m_owned = data;
+    return attach(reinterpret_cast<const uchar *>(m_owned.constData()), m_owned.size());
+}
+
+void CitiesDatabase::close()
+{
+    m_header = nullptr;
+    m_countries = nullptr;
+    m_cities = nullptr;
+    m_strings = nullptr;
+    m_countryChecks.reset();
+    m_data = nullptr;
+    m_size = 0;
+
+    if (m_file.isOpen()) {
+        m_file.close(); // unmaps as well
+    }
+    m_owned.clear();
+}
+
+bool CitiesDatabase::attach(const uchar *data, qsizetype size)
+{
+    if (reinterpret_cast<quintptr>(data) % alignof(CitiesDb::Header)) {
+        m_owned = QByteArray(reinterpret_cast<const char *>(data), size);
+        data = reinterpret_cast<const uchar *>(m_owned.constData());
+    }
+
+    m_data = data;
+    m_size = size;
+
+    if (!validate()) {
+        WRN << "Places database is corrupted or outdated, ignored";
+        close();
+        return false;
+    }
+
+    m_header = reinterpret_cast<const CitiesDb::Header *>(m_data);
+    m_countries = reinterpret_cast<const CitiesDb::Country *>(m_data + m_header->countriesOffset);
+    m_cities = reinterpret_cast<const CitiesDb::City *>(m_data + m_header->citiesOffset);
+    m_strings = reinterpret_cast<const char *>(m_data + m_header->stringsOffset);
+    m_countryChecks.reset(new std::atomic<CountryCheck>[m_header->countryCount]);
+    for (quint32 i = 0; i < m_header->countryCount; ++i) {
+        m_countryChecks[i].store(CountryCheck::Unchecked, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+bool CitiesDatabase::validate() const
+{
+    if (!m_data || m_size < qsizetype(sizeof(CitiesDb::Header))) {
+        return false;
+    }
+
+    const auto *header = reinterpret_cast<const CitiesDb::Header *>(m_data);
+    if (std::memcmp(header->magic, CitiesDb::Magic, sizeof(CitiesDb::Magic)) != 0
+        || header->version != CitiesDb::FormatVersion) {
+        return false;
+    }
+
+    auto sectionFits = [this](quint64 offset, quint64 size) {
+        return offset % 4 == 0 && offset + size <= quint64(m_size);
+    };
+
+    // the records themselves are not walked here, that would page in the whole image
+    return sectionFits(header->countriesOffset, quint64(header->countryCount) * sizeof(CitiesDb::Country))
+            && sectionFits(header->citiesOffset, quint64(header->cityCount) * sizeof(CitiesDb::City))
+            && sectionFits(header->stringsOffset, header->stringsSize);
+}
+
+bool CitiesDatabase::isCountryValid(quint32 countryIndex) const
+{
+    auto &check = m_countryChecks[countryIndex];
+    CountryCheck state = check.load(std::memory_order_acquire);
+    if (state == CountryCheck::Unchecked) {
+        // concurrent first lookups may both check, they come to the same result
+        state = validateCountry(m_countries[countryIndex]) ? CountryCheck::Valid : CountryCheck::Corrupted;
+        if (state == CountryCheck::Corrupted) {
+            WRN << "Places database entry" << countryIndex << "is corrupted, ignored";
+        }
+        check.store(state, std::memory_order_release);
+    }
+
+    return state == CountryCheck::Valid;
+}
+
+bool CitiesDatabase::validateCountry(const CitiesDb::Country &country) const
+{
+    auto stringFits = [this](const CitiesDb::StringRef &ref) {
+        return quint64(ref.offset) + ref.size <= m_header->stringsSize;
+    };
+
+    if (!stringFits(country.key) || !stringFits(country.name)
+        || quint64(country.firstCity) + country.cityCount > m_header->cityCount
+        || (country.capital != CitiesDb::NoCapital && country.capital >= m_header->cityCount)) {
+        return false;
+    }
+
+    const auto *begin = m_cities + country.firstCity;
+    const auto *end = begin + country.cityCount;
+    return std::all_of(begin, end, [&stringFits](const CitiesDb::City &city) {
+        return stringFits(city.key) && stringFits(city.name);
+    });
+}
+
+bool CitiesDatabase::isValid() const
+{
+    return m_header != nullptr;
+}
+
+quint32 CitiesDatabase::countryCount() const
+{
+    return m_header ? quint32(m_header->countryCount) : 0;
+}
+
+quint32 CitiesDatabase::cityCount() const
+{
+    return m_header ? quint32(m_header->cityCount) : 0;
+}
+
+QByteArrayView CitiesDatabase::string(const CitiesDb::StringRef &ref) const
+{
+    // the country keys are searched before their country is checked
+    if (quint64(ref.offset) + ref.size > m_header->stringsSize) {
+        return {};
+    }
+    return QByteArrayView(m_strings + ref.offset, ref.size);
+}
+
+const CitiesDb::Country *CitiesDatabase::findCountry(QByteArrayView key) const
+{
+    const auto *end = m_countries + m_header->countryCount;
+    const auto *it = std::lower_bound(m_countries, end, key,
+                                      [this](const CitiesDb::Country &country, QByteArrayView value) {
+                                          return string(country.key) < value;
+                                      });
+
+    return it != end && string(it->key) == key ? it : nullptr;
+}
+
+const CitiesDb::Country *CitiesDatabase::matchCountry(const QString &country) const
+{
+    const QString &key = PlaceNames::countryKey(country);
+    if (key.isEmpty()) {
+        return nullptr;
+    }
+
+    if (const auto *exact = findCountry(key.toUtf8())) {
+        return exact;
+    }
+
+    // few hundreds of short names, a linear scan is cheap enough for a miss
+    return closestUnique(key, m_countries, m_countries + m_header->countryCount,
+                         [this](const CitiesDb::Country &entry) { return string(entry.key); });
+}
+
+const CitiesDb::City *CitiesDatabase::findCity(const CitiesDb::Country &country, QByteArrayView key) const
+{
+    const auto *begin = m_cities + country.firstCity;
+    const auto *end = begin + country.cityCount;
+    const auto *it = std::lower_bound(begin, end, key, [this](const CitiesDb::City &city, QByteArrayView value) {
+        return string(city.key) < value;
+    });
+
+    return it != end && string(it->key) == key ? it : nullptr;
+}
+
+const CitiesDb::City *CitiesDatabase::matchCity(const CitiesDb::Country &country, const QString &key) const
+{
+    if (const auto *exact = findCity(country, key.toUtf8())) {
+        return exact;
+    }
+
+    // a miss only: scan the keys of this one country
+    const auto *begin = m_cities + country.firstCity;
+    return closestUnique(key, begin, begin + country.cityCount,
+                         [this](const CitiesDb::City &entry) { return string(entry.key); });
+}
+
+PlaceInfo CitiesDatabase::placeInfo(const CitiesDb::Country &country, const CitiesDb::City &city) const
+{
+    PlaceInfo place;
+    place.country = QString::fromUtf8(string(country.name));
+    place.town = QString::fromUtf8(string(city.name));
+    place.location = QGeoCoordinate(city.latitude / CitiesDb::CoordinateScale,
+                                    city.longitude / CitiesDb::CoordinateScale);
+    place.capital = city.flags & CitiesDb::Capital;
+    place.ok = true;
+    return place;
+}
+
+int CitiesDatabase::countryIndex(const QString &country) const
+{
+    if (!isValid()) {
+        return -1;
+    }
+
+    const auto *countryEntry = matchCountry(country);
+    return countryEntry ? int(countryEntry - m_countries) : -1;
+}
+
+PlaceInfo CitiesDatabase::lookup(const QString &country, const QString &city) const
+{
+    return lookup(countryIndex(country), city);
+}
+
+PlaceInfo CitiesDatabase::lookup(int countryIndex, const QString &city) const
+{
+    if (!isValid() || countryIndex < 0 || quint32(countryIndex) >= m_header->countryCount
+        || !isCountryValid(quint32(countryIndex))) {
+        return {};
+    }
+
+    const auto &countryEntry = m_countries[countryIndex];
+    const QString &cityKey = PlaceNames::cityKey(city);
+
+    const CitiesDb::City *cityEntry(nullptr);
+    if (cityKey.isEmpty()) {
+        if (countryEntry.capital != CitiesDb::NoCapital) {
+            cityEntry = m_cities + countryEntry.capital;
+        }
+    } else {
+        cityEntry = matchCity(countryEntry, cityKey);
+    }
+
+    return cityEntry ? placeInfo(countryEntry, *cityEntry) : PlaceInfo();
+}
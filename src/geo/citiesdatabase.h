@@ -0,0 +1,88 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+This application is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This application is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include "geo/citiesdbformat.h"
+#include "geo/placeinfo.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <atomic>
+#include <memory>
+
+// Read-only view of the compiled places database, mapped in place: only the pages of the
+// countries actually looked up become resident, nothing is decoded ahead of a lookup.
+// Opening checks the header and the section bounds, a country's cities are checked on its first lookup.
+class CitiesDatabase
+{
+public:
+    static constexpr QLatin1StringView BuiltinPath { ":/geo/resources/map/cities.bin" };
+
+    CitiesDatabase() = default;
+    ~CitiesDatabase();
+
+    CitiesDatabase(const CitiesDatabase &) = delete;
+    CitiesDatabase &operator=(const CitiesDatabase &) = delete;
+
+    static const CitiesDatabase &builtin();
+
+    bool open(const QString &path);
+    bool openData(const QByteArray &data);
+    void close();
+
+    bool isValid() const;
+    quint32 countryCount() const;
+    quint32 cityCount() const;
+
+    // -1 if unknown
+    int countryIndex(const QString &country) const;
+    PlaceInfo lookup(const QString &country, const QString &city) const;
+    // an empty city means the capital; a typo resolves to the closest key only if no other is as close
+    PlaceInfo lookup(int countryIndex, const QString &city) const;
+
+private:
+    QFile m_file;
+    QByteArray m_owned;
+    const uchar *m_data { nullptr };
+    qsizetype m_size { 0 };
+
+    const CitiesDb::Header *m_header { nullptr };
+    const CitiesDb::Country *m_countries { nullptr };
+    const CitiesDb::City *m_cities { nullptr };
+    const char *m_strings { nullptr };
+
+    enum class CountryCheck : quint8
+    {
+        Unchecked,
+        Valid,
+        Corrupted,
+    };
+    std::unique_ptr<std::atomic<CountryCheck>[]> m_countryChecks;
+
+    bool attach(const uchar *data, qsizetype size);
+    bool validate() const;
+    bool isCountryValid(quint32 countryIndex) const;
+    bool validateCountry(const CitiesDb::Country &country) const;
+
+    QByteArrayView string(const CitiesDb::StringRef &ref) const;
+    const CitiesDb::Country *findCountry(QByteArrayView key) const;
+    const CitiesDb::Country *matchCountry(const QString &country) const;
+    const CitiesDb::City *findCity(const CitiesDb::Country &country, QByteArrayView key) const;
+    const CitiesDb::City *matchCity(const CitiesDb::Country &country, const QString &key) const;
+    PlaceInfo placeInfo(const CitiesDb::Country &country, const CitiesDb::City &city) const;
+};
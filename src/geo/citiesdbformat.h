@@ -0,0 +1,74 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include <QtEndian>
+
+// On-disk layout of the compiled places database (see tools/citiesdbgen).
+// All the integers are little-endian, the strings are UTF-8 slices of the trailing pool.
+// Countries are sorted by their key, and cities are sorted by key within each country, both in the
+// byte order of the UTF-8 keys. The keys are PlaceNames::countryKey() and PlaceNames::cityKey().
+namespace CitiesDb {
+
+inline constexpr char Magic[4] { 'Y', 'C', 'D', 'B' };
+inline constexpr quint32 FormatVersion = 2;
+inline constexpr quint32 NoCapital = 0xffffffff;
+inline constexpr double CoordinateScale = 1e6; // fixed-point micro-degrees
+
+enum CityFlag : quint32
+{
+    Capital = 0x1,
+};
+
+struct Header {
+    char magic[4];
+    quint32_le version;
+    quint32_le countryCount;
+    quint32_le cityCount;
+    quint32_le countriesOffset;
+    quint32_le citiesOffset;
+    quint32_le stringsOffset;
+    quint32_le stringsSize;
+};
+
+struct StringRef {
+    quint32_le offset;
+    quint32_le size;
+};
+
+struct Country {
+    StringRef key;
+    StringRef name;
+    quint32_le firstCity;
+    quint32_le cityCount;
+    quint32_le capital; // absolute city index or NoCapital
+};
+
+struct City {
+    StringRef key;
+    StringRef name;
+    qint32_le latitude;
+    qint32_le longitude;
+    quint32_le flags;
+};
+
+static_assert(sizeof(Header) == 32);
+static_assert(sizeof(Country) == 28);
+static_assert(sizeof(City) == 28);
+
+} // namespace CitiesDb
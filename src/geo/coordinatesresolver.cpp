@@ -18,39 +18,39 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html
 #include "coordinatesresolver.h"
 
 #include "app/common.h"
+#include "geo/geocodinggovernor.h"
 
-#include <QFile>
-#include <QFutureSynchronizer>
 #include <QFutureWatcher>
-#include <QGeoAddress>
-#include <QGeoCodeReply>
-#include <QGeoCodingManager>
-#include <QGeoLocation>
 #include <QtConcurrentRun>
 
-static constexpr QChar CSVSeparator(',');
-static constexpr size_t CSVColumnCount(5);
-
-CoordinatesResolver::CoordinatesResolver(QObject *parent)
+CoordinatesResolver::CoordinatesResolver(const QString &missesFilePath, QObject *parent)
     : QObject { parent }
-    , m_geoSrvProv(std::make_unique<QGeoServiceProvider>("osm"))
-    , m_geoCoder(m_geoSrvProv->geocodingManager())
+    , m_geocoding(new GeocodingGovernor(missesFilePath, {}, this))
 {
-    if (m_geoCoder) {
-        QLocale qLocaleC(QLocale::C, QLocale::AnyCountry);
-        m_geoCoder->setLocale(qLocaleC);
+    connect(m_geocoding, &GeocodingGovernor::resolved, this, &CoordinatesResolver::coordinatesResolved);
+
+    const auto &database = warmUp();
+    if (database.isFinished()) {
+        m_database = database.result();
     } else {
-        WRN << "Can't aquire geocoder" << m_geoSrvProv->geocodingManager();
+        auto *watcher = new QFutureWatcher<const CitiesDatabase *>(this);
+        connect(watcher, &QFutureWatcher<const CitiesDatabase *>::finished, this, [this, watcher]() {
+            watcher->deleteLater();
+            onDatabaseReady(watcher->result());
+        });
+        watcher->setFuture(database);
     }
 }
 
 quint32 CoordinatesResolver::requestCoordinates(const PlaceInfo &town)
 {
-    ensureDataLoaded();
-
     ++m_requestCounter; // overflow on around 4 billion requests, then goes back to the zero
 
-    lookupForPlaceAsync(town, m_requestCounter);
+    if (isReady()) {
+        lookupForPlaceAsync(town, m_requestCounter);
+    } else {
+        m_pending.append({ town, m_requestCounter });
+    }
     return m_requestCounter;
 }
 
@@ -59,81 +59,33 @@ quint32 CoordinatesResolver::requestCoordinates(const QString &country, const QS
     return requestCoordinates({ country, city });
 }
 
-void CoordinatesResolver::ensureDataLoaded()
+/*static*/ QFuture<const CitiesDatabase *> CoordinatesResolver::warmUp()
 {
-    QFutureSynchronizer<void> synchronizer;
-
-    static bool loadedBuiltin(false);
-    if (!loadedBuiltin) {
-        synchronizer.addFuture(QtConcurrent::run([this]() {
-            const auto &loaded = loadData(":/geo/resources/map/cities.csv");
-
-            if (!loaded.isEmpty()) {
-                m_data.insert(loaded);
-            }
-        }));
-        loadedBuiltin = true;
-    }
+    static const QFuture<const CitiesDatabase *> database =
+            QtConcurrent::run([]() -> const CitiesDatabase * { return &CitiesDatabase::builtin(); });
+    return database;
+}
 
-    synchronizer.waitForFinished();
+bool CoordinatesResolver::isReady() const
+{
+    return m_database != nullptr;
 }
 
-CitiesByCountry CoordinatesResolver::loadData(const QString &path)
+GeocodingGovernor *CoordinatesResolver::geocoding() const
 {
-    auto parseLine = [](const QString &line, QChar separator = ',') {
-        QStringList result;
-        QString field;
-        bool insideQuotes = false;
-
-        for (int i = 0; i < line.length(); ++i) {
-            const auto &c = line[i];
-
-            if (c == '"') {
-                insideQuotes = !insideQuotes;
-            } else if (c == separator && !insideQuotes) {
-                result.append(field.trimmed());
-                field.clear();
-            } else {
-                field += c;
-            }
-        }
-        result.append(field.trimmed());
-        return result;
-    };
-
-    CitiesByCountry loaded;
-
-    QFile csv(path);
-    if (csv.open(QFile::ReadOnly | QFile::Text)) {
-        while (!csv.atEnd()) {
-            const auto &line = QString::fromUtf8(csv.readLine());
-            const auto &parts = parseLine(line, CSVSeparator);
-            if (parts.size() != CSVColumnCount) {
-                WRN << QString("Invalid geo line '%1', expected %2 separators (%3) but got %4, ignored")
-                                .arg(line, QString::number(CSVColumnCount), CSVSeparator,
-                                     QString::number(parts.size()));
-                continue;
-            }
-
-            const auto [coord, parsed] = utils::parseCoordinates(parts[3], parts[4]);
-            if (!parsed) {
-                WRN << "Failed parsing lat/lon value:" << parts[3] << parts[4];
-                continue;
-            }
-
-            const PlaceInfo place {
-                parts[0], parts[1], coord, parts[2] == "True", true, QString(),
-            };
-
-            auto &country = loaded[place.country.toLower()];
-            country.insert(place.town.toLower(), place);
-        }
+    return m_geocoding;
+}
 
-    } else {
-        WRN << QString("Places database file '%1' not found: %2").arg(path, csv.errorString());
+void CoordinatesResolver::onDatabaseReady(const CitiesDatabase *database)
+{
+    m_database = database;
+
+    const auto pending = std::exchange(m_pending, {});
+    for (const auto &[place, id] : pending) {
+        lookupForPlaceAsync(place, id);
     }
 
-    return loaded;
+    emit ready();
 }
 
 void CoordinatesResolver::lookupForPlaceAsync(const PlaceInfo &request, RequestId id)
@@ -156,92 +108,43 @@ void CoordinatesResolver::lookupForPlaceAsync(const PlaceInfo &request, RequestI
     watcher->setFuture(future);
 }
 
-PlaceInfo CoordinatesResolver::lookupForPlace(const PlaceInfo &request) const
+PlaceInfo CoordinatesResolver::lookupForPlace(const PlaceInfo &request)
 {
+    // the servers list names a country without cities "default" (see nvpnToGeo), that's its capital
+    const QString &town = request.town == QLatin1String("default") ? QString() : request.town;
+    const PlaceInfo &found = m_database->lookup(countryIndex(request.country), town);
+    if (found.ok) {
+        return found;
+    }
+
     PlaceInfo town(request);
     town.ok = false;
     town.message = "Not found";
-
-    auto searchForTheCapital = [&town](const auto &place) {
-        return place.capital && place.country.toLower() == town.country.toLower();
-    };
-
-    const auto &countryName = town.country.toLower();
-    const auto &cityName = town.town.toLower();
-
-    if (m_data.contains(countryName)) {
-        const auto &country = m_data[countryName];
-        if (town.town.isEmpty()) {
-            auto it = std::find_if(country.cbegin(), country.cend(), searchForTheCapital);
-            if (it != country.end()) {
-                town = *it;
-                town.ok = true;
-            }
-        } else if (country.contains(cityName)) {
-            town = country.value(cityName);
-            town.ok = true;
-        }
-    }
-
     return town;
 }
 
-void CoordinatesResolver::requestGeoAsync(const PlaceInfo &place, RequestId id)
+int CoordinatesResolver::countryIndex(const QString &country)
 {
-    PlaceInfo result(place);
-    result.ok = false;
-    result.message = "Not found";
-
-    if (!m_geoCoder) {
-        WRN << "GeoCoder is unavailable" << place.country << place.town;
-        emit coordinatesResolved(id, result);
-        return;
-    }
-
-    QGeoAddress addr;
-    addr.setCountry(place.country);
-    if (place.town != "default") {
-        addr.setCity(place.town);
-    }
-    LOG << addr.country() << addr.city();
-
-    QGeoCodeReply *reply = m_geoCoder->geocode(addr);
-    if (!reply) {
-        result.message = "Failed to create geocode request!";
-        WRN << result.message;
-        emit coordinatesResolved(id, result);
-        return;
-    }
-
-    connect(reply, &QGeoCodeReply::finished, this, [this, reply, id, result]() mutable {
-        QScopedPointer<QGeoCodeReply, QScopedPointerDeleteLater> cleanup(reply); // auto deletes reply safely
-
-        if (reply->error() != QGeoCodeReply::NoError) {
-            result.message = QString("Geo reply error: %1").arg(reply->errorString());
-            emit coordinatesResolved(id, result);
-            return;
+    {
+        QMutexLocker locker(&m_countriesMutex);
+        const auto it = m_countries.constFind(country);
+        if (it != m_countries.cend()) {
+            return it.value();
         }
+    }
 
-        const auto &locations = reply->locations();
-        if (!locations.isEmpty()) {
-            const auto &l = locations.first();
-            LOG << result.country << result.town << l.coordinate();
-            result.location = l.coordinate();
-            result.ok = true;
-            result.message.clear();
-        } else {
-            result.message = QString("No locations found for: `%1` `%2`").arg(result.country, result.town);
-            WRN << result.message;
-        }
+    // resolved unlocked: concurrent lookups of the same name store the same value
+    const int index = m_database->countryIndex(country);
 
-        emit coordinatesResolved(id, result);
-    });
+    QMutexLocker locker(&m_countriesMutex);
+    if (m_countries.size() >= MaxCountries) {
+        m_countries.clear();
+    }
+    m_countries.insert(country, index);
+    return index;
+}
 
-    // Optionally handle network errors immediately
-    // connect(reply, &QGeoCodeReply::errorOccurred, this, [this, reply, id, result](QGeoCodeReply::Error error) mutable
-    // {
-    //     WRN << "Geo reply error occurred:" << error << reply->errorString();
-    //     reply->deleteLater();
-    //     emit coordinatesResolved(id, result);
-    // });
+void CoordinatesResolver::requestGeoAsync(const PlaceInfo &place, RequestId id)
+{
+    m_geocoding->geocode(id, place);
 }
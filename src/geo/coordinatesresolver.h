@@ -17,14 +17,16 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html
 
 #pragma once
 
+#include "geo/citiesdatabase.h"
 #include "geo/placeinfo.h"
 
-#include <QGeoServiceProvider>
+#include <QFuture>
 #include <QHash>
+#include <QMutex>
 #include <QObject>
 #include <atomic>
 
-class QGeoCodingManager;
+class GeocodingGovernor;
 
 inline bool operator==(const PlaceInfo &lhs, const PlaceInfo &rhs)
 {
@@ -41,31 +43,42 @@ class CoordinatesResolver : public QObject
 {
     Q_OBJECT
 public:
-    explicit CoordinatesResolver(QObject *parent = nullptr);
+    // the online lookup misses are kept in the missesFilePath, or in memory only if it's empty
+    explicit CoordinatesResolver(const QString &missesFilePath = {}, QObject *parent = nullptr);
 
     RequestId requestCoordinates(const PlaceInfo &town);
     RequestId requestCoordinates(const QString &country, const QString &city);
 
+    static QFuture<const CitiesDatabase *> warmUp();
+    bool isReady() const;
+
+    GeocodingGovernor *geocoding() const;
+
 signals:
     void coordinatesResolved(RequestId id, const PlaceInfo &town);
+    void ready();
 
 private:
     std::atomic<RequestId> m_requestCounter { 0 };
 
-    CitiesByCountry m_data;
+    const CitiesDatabase *m_database { nullptr };
+    QList<QPair<PlaceInfo, RequestId>> m_pending;
 
-    std::unique_ptr<QGeoServiceProvider> m_geoSrvProv;
-    QGeoCodingManager *m_geoCoder { nullptr };
+    // requested country name -> database index, the only lookup state kept on the heap
+    static constexpr qsizetype MaxCountries = 1024;
+    QMutex m_countriesMutex;
+    QHash<QString, int> m_countries;
 
-    void ensureDataLoaded();
+    GeocodingGovernor *m_geocoding { nullptr };
+
+    void onDatabaseReady(const CitiesDatabase *database);
 
     void lookupForPlaceAsync(const PlaceInfo &request, RequestId id);
 
-    PlaceInfo lookupForPlace(const PlaceInfo &request) const;
+    PlaceInfo lookupForPlace(const PlaceInfo &request);
+    int countryIndex(const QString &country);
 
     void requestGeoAsync(const PlaceInfo &place, RequestId id);
 
-    static CitiesByCountry loadData(const QString &path);
-
     friend class TestCoordinatesResolver;
 };
@@ -39,6 +39,7 @@ void FlatPlaceProxyModel::setSourceModel(QAbstractItemModel *model)
         connect(model, &QAbstractItemModel::rowsInserted, this, &FlatPlaceProxyModel::onRowsInserted);
         connect(model, &QAbstractItemModel::rowsRemoved, this, &FlatPlaceProxyModel::onRowsRemoved);
         connect(model, &QAbstractItemModel::modelReset, this, &FlatPlaceProxyModel::rebuildFlatList);
+        connect(model, &QAbstractItemModel::dataChanged, this, &FlatPlaceProxyModel::onDataChanged);
     }
 
     rebuildFlatList();
@@ -160,6 +161,9 @@ QVariant FlatPlaceProxyModel::data(const QModelIndex &index, int role) const
         case FlatPlaceProxyModel::Roles::PlaceInfoRole: {
             return QVariant::fromValue(place);
         }
+        case FlatPlaceProxyModel::Roles::StatsRole: {
+            return placeIndex.data(MapServersModel::StatsRole);
+        }
         default:
             break;
         }
@@ -175,6 +179,7 @@ QHash<int, QByteArray> FlatPlaceProxyModel::roleNames() const
         { CountryNameRole, "country" },
         { CityNameRole, "city" },
         { PlaceInfoRole, "placeInfo" },
+        { StatsRole, "stats" },
     };
 }
 
@@ -210,3 +215,26 @@ void FlatPlaceProxyModel::onRowsInserted(const QModelIndex &parent, int first, i
         endInsertRows();
     }
 }
+
+void FlatPlaceProxyModel::onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                                        const QList<int> &roles)
+{
+    QList<int> proxyRoles;
+    for (const int role : roles) {
+        if (role == MapServersModel::StatsRole) {
+            proxyRoles.append(StatsRole);
+        } else if (role == MapServersModel::PlaceInfoRole) {
+            proxyRoles.append({ PositionRole, CountryNameRole, CityNameRole, PlaceInfoRole });
+        }
+    }
+    if (!roles.isEmpty() && proxyRoles.isEmpty()) {
+        return;
+    }
+
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        const QModelIndex &proxyIndex = mapFromSource(topLeft.siblingAtRow(row));
+        if (proxyIndex.isValid()) {
+            emit dataChanged(proxyIndex, proxyIndex, proxyRoles);
+        }
+    }
+}
@@ -30,6 +30,7 @@ public:
         CountryNameRole,
         CityNameRole,
         PlaceInfoRole,
+        StatsRole,
     };
 
     explicit FlatPlaceProxyModel(QObject *parent = nullptr);
@@ -54,4 +55,5 @@ private slots:
     void rebuildFlatList();
     void onRowsInserted(const QModelIndex &parent, int first, int last);
     void onRowsRemoved(const QModelIndex &parent, int first, int last);
+    void onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles);
 };
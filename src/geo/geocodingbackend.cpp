@@ -0,0 +1,83 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+This application is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This application is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "geocodingbackend.h"
+
+#include "app/common.h"
+
+#include <QGeoAddress>
+#include <QGeoCodeReply>
+#include <QGeoCodingManager>
+#include <QGeoLocation>
+#include <QGeoServiceProvider>
+
+OsmGeocodingBackend::OsmGeocodingBackend(QObject *parent)
+    : GeocodingBackend(parent)
+{
+}
+
+OsmGeocodingBackend::~OsmGeocodingBackend() = default;
+
+void OsmGeocodingBackend::geocode(quint64 ticket, const QString &country, const QString &city)
+{
+    if (!m_geoSrvProv) {
+        m_geoSrvProv = std::make_unique<QGeoServiceProvider>("osm");
+        if (auto *geoCoder = m_geoSrvProv->geocodingManager()) {
+            geoCoder->setLocale(QLocale(QLocale::C, QLocale::AnyCountry));
+        } else {
+            WRN << "Can't aquire geocoder" << m_geoSrvProv->errorString();
+        }
+    }
+
+    QGeoCodingManager *geoCoder = m_geoSrvProv->geocodingManager();
+    if (!geoCoder) {
+        finishLater(ticket, "GeoCoder is unavailable");
+        return;
+    }
+
+    QGeoAddress addr;
+    addr.setCountry(country);
+    if (city != "default") {
+        addr.setCity(city);
+    }
+    LOG << addr.country() << addr.city();
+
+    QGeoCodeReply *reply = geoCoder->geocode(addr);
+    if (!reply) {
+        finishLater(ticket, "Failed to create geocode request!");
+        return;
+    }
+
+    connect(reply, &QGeoCodeReply::finished, this, [this, reply, ticket]() {
+        QScopedPointer<QGeoCodeReply, QScopedPointerDeleteLater> cleanup(reply); // auto deletes reply safely
+
+        if (reply->error() != QGeoCodeReply::NoError) {
+            emit finished(ticket, {}, QString("Geo reply error: %1").arg(reply->errorString()));
+            return;
+        }
+
+        const auto &locations = reply->locations();
+        emit finished(ticket, locations.isEmpty() ? QGeoCoordinate() : locations.first().coordinate(), {});
+    });
+}
+
+void OsmGeocodingBackend::finishLater(quint64 ticket, const QString &error)
+{
+    WRN << error;
+    QMetaObject::invokeMethod(
+            this, [this, ticket, error]() { emit finished(ticket, {}, error); }, Qt::QueuedConnection);
+}
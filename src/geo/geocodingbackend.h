@@ -0,0 +1,53 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+This application is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This application is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include <QGeoCoordinate>
+#include <QObject>
+#include <memory>
+
+class QGeoServiceProvider;
+
+class GeocodingBackend : public QObject
+{
+    Q_OBJECT
+public:
+    using QObject::QObject;
+
+    // finished() is emitted once per ticket, never from within geocode()
+    virtual void geocode(quint64 ticket, const QString &country, const QString &city) = 0;
+
+signals:
+    // an invalid location without an error means the place is unknown to the backend
+    void finished(quint64 ticket, const QGeoCoordinate &location, const QString &error);
+};
+
+class OsmGeocodingBackend : public GeocodingBackend
+{
+    Q_OBJECT
+public:
+    explicit OsmGeocodingBackend(QObject *parent = {});
+    ~OsmGeocodingBackend() override;
+
+    void geocode(quint64 ticket, const QString &country, const QString &city) override;
+
+private:
+    std::unique_ptr<QGeoServiceProvider> m_geoSrvProv;
+
+    void finishLater(quint64 ticket, const QString &error);
+};
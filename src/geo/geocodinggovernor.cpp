@@ -0,0 +1,284 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+This application is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This application is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "geocodinggovernor.h"
+
+#include "app/common.h"
+#include "app/jsonfilestore.h"
+#include "geo/geocodingbackend.h"
+#include "geo/placenames.h"
+#include "settings/settingsmanager.h"
+
+#include <QDateTime>
+#include <QJsonObject>
+#include <QTimer>
+
+namespace JsonConsts {
+static const QLatin1String Key { "key" };
+static const QLatin1String Expires { "expires" };
+};
+
+static constexpr int MissesFormatVersion = 1;
+
+GeocodingGovernor::GeocodingGovernor(const QString &filePath, const BackendFactory &factory, QObject *parent)
+    : QObject(parent)
+    , m_store(new JsonFileStore(filePath, MissesFormatVersion, this))
+    , m_factory(factory ? factory : []() -> GeocodingBackend * { return new OsmGeocodingBackend; })
+    , m_intervalMs(DefaultIntervalMs)
+    , m_concurrency(DefaultConcurrency)
+    , m_missTtlSecs(DefaultMissTtlSecs)
+    , m_pumpTimer(new QTimer(this))
+{
+    m_pumpTimer->setSingleShot(true);
+    connect(m_pumpTimer, &QTimer::timeout, this, &GeocodingGovernor::pump);
+
+    m_store->setWriter([this]() { return toJson(); });
+
+    load();
+}
+
+GeocodingGovernor::~GeocodingGovernor()
+{
+    m_store->flush();
+}
+
+/*static*/ QString GeocodingGovernor::defaultFilePath()
+{
+    return QString("%1/geocoding_misses.json").arg(SettingsManager::dirPath());
+}
+
+QString GeocodingGovernor::filePath() const
+{
+    return m_store->filePath();
+}
+
+void GeocodingGovernor::setInterval(int ms)
+{
+    m_intervalMs = qMax(0, ms);
+}
+
+int GeocodingGovernor::interval() const
+{
+    return m_intervalMs;
+}
+
+void GeocodingGovernor::setConcurrency(int count)
+{
+    m_concurrency = qMax(1, count);
+    schedulePump();
+}
+
+int GeocodingGovernor::concurrency() const
+{
+    return m_concurrency;
+}
+
+void GeocodingGovernor::setMissTtl(qint64 secs)
+{
+    m_missTtlSecs = qMax<qint64>(0, secs);
+}
+
+qint64 GeocodingGovernor::missTtl() const
+{
+    return m_missTtlSecs;
+}
+
+/*static*/ QString GeocodingGovernor::key(const PlaceInfo &place)
+{
+    return QString("%1|%2").arg(PlaceNames::countryKey(place.country), PlaceNames::cityKey(place.town));
+}
+
+bool GeocodingGovernor::hasBackend() const
+{
+    return m_backend != nullptr;
+}
+
+int GeocodingGovernor::pendingCount() const
+{
+    return static_cast<int>(m_queue.size());
+}
+
+int GeocodingGovernor::runningCount() const
+{
+    return static_cast<int>(m_running.size());
+}
+
+bool GeocodingGovernor::isKnownMiss(const PlaceInfo &place) const
+{
+    return m_misses.value(key(place), 0) > QDateTime::currentSecsSinceEpoch();
+}
+
+void GeocodingGovernor::geocode(RequestId id, const PlaceInfo &place)
+{
+    if (isKnownMiss(place)) {
+        LOG << place.country << place.town << "is a known miss";
+        finishLater({ { id, place } }, {}, {});
+        return;
+    }
+
+    const QString &placeKey = key(place);
+    auto it = m_jobs.find(placeKey);
+    if (it != m_jobs.end()) {
+        LOG << place.country << place.town << "is already requested";
+        it->waiters.append({ id, place });
+        return;
+    }
+
+    m_jobs.insert(placeKey, { place.country, place.town, { { id, place } } });
+    m_queue.append(placeKey);
+    schedulePump();
+}
+
+GeocodingBackend *GeocodingGovernor::backend()
+{
+    if (!m_backend) {
+        m_backend = m_factory();
+        if (m_backend) {
+            m_backend->setParent(this);
+            connect(m_backend, &GeocodingBackend::finished, this, &GeocodingGovernor::onBackendFinished);
+        }
+    }
+
+    return m_backend;
+}
+
+void GeocodingGovernor::schedulePump()
+{
+    if (!m_pumpTimer->isActive()) {
+        m_pumpTimer->start(0);
+    }
+}
+
+void GeocodingGovernor::pump()
+{
+    while (!m_queue.isEmpty() && m_running.size() < m_concurrency) {
+        if (m_sinceStart.isValid()) {
+            const qint64 wait = m_intervalMs - m_sinceStart.elapsed();
+            if (wait > 0) {
+                m_pumpTimer->start(static_cast<int>(wait));
+                return;
+            }
+        }
+
+        const QString placeKey = m_queue.takeFirst();
+        auto it = m_jobs.find(placeKey);
+        if (it == m_jobs.end()) {
+            continue;
+        }
+
+        auto *geoCoder = backend();
+        if (!geoCoder) {
+            WRN << "GeoCoder is unavailable" << it->country << it->city;
+            finishLater(it->waiters, {}, "GeoCoder is unavailable");
+            m_jobs.erase(it);
+            continue;
+        }
+
+        const quint64 ticket = ++m_ticketCounter;
+        m_running.insert(ticket, placeKey);
+        m_sinceStart.start();
+        geoCoder->geocode(ticket, it->country, it->city);
+    }
+}
+
+void GeocodingGovernor::onBackendFinished(quint64 ticket, const QGeoCoordinate &location, const QString &error)
+{
+    const QString &placeKey = m_running.take(ticket);
+    if (placeKey.isEmpty()) {
+        return;
+    }
+
+    const Job &job = m_jobs.take(placeKey);
+    LOG << job.country << job.city << location << error;
+
+    // only a definite "unknown place" is remembered, errors may be gone on the next try
+    if (!location.isValid() && error.isEmpty() && m_missTtlSecs > 0) {
+        m_misses.insert(placeKey, QDateTime::currentSecsSinceEpoch() + m_missTtlSecs);
+        m_store->scheduleSave();
+    }
+
+    finishLater(job.waiters, location, error);
+    schedulePump();
+}
+
+void GeocodingGovernor::finishLater(const QList<Waiter> &waiters, const QGeoCoordinate &location,
+                                    const QString &message)
+{
+    QMetaObject::invokeMethod(
+            this,
+            [this, waiters, location, message]() {
+                for (const auto &waiter : waiters) {
+                    PlaceInfo result(waiter.place);
+                    result.location = location;
+                    result.ok = location.isValid();
+                    if (result.ok) {
+                        result.message.clear();
+                    } else {
+                        result.message = message.isEmpty() ? QString("No locations found for: `%1` `%2`")
+                                                                     .arg(result.country, result.town)
+                                                           : message;
+                    }
+
+                    emit resolved(waiter.id, result);
+                }
+            },
+            Qt::QueuedConnection);
+}
+
+void GeocodingGovernor::clearMisses()
+{
+    m_misses.clear();
+    m_store->scheduleSave();
+}
+
+void GeocodingGovernor::load()
+{
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    const QJsonArray &jArr = m_store->read();
+    for (const auto &jVal : jArr) {
+        const QJsonObject &jObj = jVal.toObject();
+        const QString &placeKey = jObj.value(JsonConsts::Key).toString();
+        const qint64 expires = jObj.value(JsonConsts::Expires).toInteger();
+        if (!placeKey.isEmpty() && expires > now) {
+            m_misses.insert(placeKey, expires);
+        }
+    }
+
+    if (!m_misses.isEmpty()) {
+        LOG << "loaded" << m_misses.size() << "geocoding misses from" << filePath();
+    }
+}
+
+void GeocodingGovernor::save()
+{
+    m_store->save();
+}
+
+QJsonArray GeocodingGovernor::toJson() const
+{
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    QJsonArray jArr;
+    for (auto it = m_misses.cbegin(); it != m_misses.cend(); ++it) {
+        if (it.value() > now) {
+            jArr.append(QJsonObject {
+                    { JsonConsts::Key, it.key() },
+                    { JsonConsts::Expires, it.value() },
+            });
+        }
+    }
+    return jArr;
+}
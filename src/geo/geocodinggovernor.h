@@ -0,0 +1,113 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+This application is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This application is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include "geo/placeinfo.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QObject>
+#include <functional>
+
+class GeocodingBackend;
+class JsonFileStore;
+class QTimer;
+
+// Sits between the resolver and the online geocoder: identical requests in flight share a single lookup,
+// lookups are started no more often than the interval and no more than the concurrency at once,
+// and places the geocoder doesn't know are remembered for the TTL.
+class GeocodingGovernor : public QObject
+{
+    Q_OBJECT
+public:
+    using BackendFactory = std::function<GeocodingBackend *()>;
+
+    static constexpr int DefaultIntervalMs = 1000; // the OSM Nominatim usage policy
+    static constexpr int DefaultConcurrency = 1;
+    static constexpr qint64 DefaultMissTtlSecs = 7 * 24 * 60 * 60;
+
+    // an empty file path keeps the misses in memory only; the default factory provides the OSM geocoder
+    explicit GeocodingGovernor(const QString &filePath, const BackendFactory &factory = {}, QObject *parent = {});
+    ~GeocodingGovernor() override;
+
+    static QString defaultFilePath();
+    QString filePath() const;
+
+    void setInterval(int ms);
+    int interval() const;
+
+    void setConcurrency(int count);
+    int concurrency() const;
+
+    void setMissTtl(qint64 secs);
+    qint64 missTtl() const;
+
+    void geocode(RequestId id, const PlaceInfo &place);
+
+    bool hasBackend() const;
+    int pendingCount() const;
+    int runningCount() const;
+    bool isKnownMiss(const PlaceInfo &place) const;
+
+signals:
+    void resolved(RequestId id, const PlaceInfo &place);
+
+public slots:
+    void clearMisses();
+    void load();
+    void save();
+
+private:
+    struct Waiter {
+        RequestId id;
+        PlaceInfo place;
+    };
+
+    struct Job {
+        QString country;
+        QString city;
+        QList<Waiter> waiters;
+    };
+
+    JsonFileStore *m_store;
+    BackendFactory m_factory;
+    GeocodingBackend *m_backend { nullptr };
+
+    QHash<QString, Job> m_jobs;
+    QList<QString> m_queue;
+    QHash<quint64, QString> m_running;
+    quint64 m_ticketCounter { 0 };
+    QElapsedTimer m_sinceStart;
+
+    QHash<QString, qint64> m_misses; // key -> expiration, secs since epoch
+
+    int m_intervalMs;
+    int m_concurrency;
+    qint64 m_missTtlSecs;
+    QTimer *m_pumpTimer;
+
+    static QString key(const PlaceInfo &place);
+
+    GeocodingBackend *backend();
+    void schedulePump();
+    void pump();
+    void onBackendFinished(quint64 ticket, const QGeoCoordinate &location, const QString &error);
+    void finishLater(const QList<Waiter> &waiters, const QGeoCoordinate &location, const QString &message);
+    QJsonArray toJson() const;
+};
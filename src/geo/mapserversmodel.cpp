@@ -18,6 +18,7 @@
 #include "mapserversmodel.h"
 
 #include "app/common.h"
+#include "app/connectionstats.h"
 
 MapServersModel::MapServersModel(QObject *parent)
     : QAbstractItemModel(parent)
@@ -80,6 +81,10 @@ QVariant MapServersModel::data(const QModelIndex &index, int role) const
         case PlaceInfoRole: {
             return QVariant::fromValue(item->data);
         }
+        case Qt::ToolTipRole:
+        case StatsRole: {
+            return statsText(item);
+        }
         default:
             break;
         }
@@ -155,3 +160,55 @@ void MapServersModel::clear()
     m_root->children.clear(); // unique_ptr handles recursive deletion
     endResetModel();
 }
+
+void MapServersModel::setConnectionStats(const ConnectionStats *stats)
+{
+    if (m_stats) {
+        disconnect(m_stats, nullptr, this, nullptr);
+    }
+
+    m_stats = stats;
+
+    if (m_stats) {
+        connect(m_stats, &ConnectionStats::updated, this, &MapServersModel::onStatsUpdated);
+    }
+
+    onStatsUpdated({}, {});
+}
+
+QString MapServersModel::statsText(const TreeItem *item) const
+{
+    if (!m_stats || item->data.isGroup()) {
+        return {};
+    }
+
+    const bool isCountry = item->parent == m_root;
+    const QString &country = isCountry ? item->name : item->parent->name;
+    return m_stats->summary(country, isCountry ? QString() : item->name).toString();
+}
+
+void MapServersModel::emitItemChanged(TreeItem *item)
+{
+    const QModelIndex &index = createIndex(item->row(), 0, item);
+    emit dataChanged(index, index, { Qt::ToolTipRole, StatsRole });
+}
+
+void MapServersModel::onStatsUpdated(const QString &country, const QString &city)
+{
+    const QString &countryName = utils::nvpnToGeo(country);
+    const QString &cityName = utils::nvpnToGeo(city);
+
+    for (const auto &countryItem : m_root->children) {
+        if (!country.isEmpty() && countryItem->name.compare(countryName, Qt::CaseInsensitive) != 0) {
+            continue;
+        }
+
+        // the country aggregates its cities
+        emitItemChanged(countryItem.get());
+        for (const auto &cityItem : countryItem->children) {
+            if (country.isEmpty() || cityItem->name.compare(cityName, Qt::CaseInsensitive) == 0) {
+                emitItemChanged(cityItem.get());
+            }
+        }
+    }
+}
@@ -20,6 +20,9 @@
 #include "geo/coordinatesresolver.h"
 
 #include <QAbstractListModel>
+#include <QPointer>
+
+class ConnectionStats;
 
 struct TreeItem {
     QString name;
@@ -56,6 +59,7 @@ public:
     enum Roles
     {
         PlaceInfoRole = Qt::UserRole + 1,
+        StatsRole,
     };
 
     MapServersModel(QObject *parent = nullptr);
@@ -72,6 +76,15 @@ public:
 
     TreeItem *rootItem() const;
 
+    void setConnectionStats(const ConnectionStats *stats);
+
+private slots:
+    void onStatsUpdated(const QString &country, const QString &city);
+
 private:
     TreeItem *m_root;
+    QPointer<const ConnectionStats> m_stats;
+
+    QString statsText(const TreeItem *item) const;
+    void emitItemChanged(TreeItem *item);
 };
@@ -39,7 +39,6 @@ private:
 };
 
 using Places = QList<PlaceInfo>;
-using CitiesByCountry = QMap<QString, QMultiMap<QString, PlaceInfo>>;
 using RequestId = quint32;
 
 Q_DECLARE_METATYPE(PlaceInfo)
@@ -0,0 +1,195 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+This application is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This application is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "placenames.h"
+
+#include <QHash>
+#include <QStringList>
+#include <QVarLengthArray>
+
+namespace {
+
+const QHash<QChar, QLatin1StringView> &transliterations()
+{
+    // letters NFKD doesn't decompose
+    static const QHash<QChar, QLatin1StringView> table {
+        { QChar(0x00df), QLatin1StringView("ss") }, // ß
+        { QChar(0x00e6), QLatin1StringView("ae") }, // æ
+        { QChar(0x0153), QLatin1StringView("oe") }, // œ
+        { QChar(0x00f8), QLatin1StringView("o") },  // ø
+        { QChar(0x0142), QLatin1StringView("l") },  // ł
+        { QChar(0x0111), QLatin1StringView("d") },  // đ
+        { QChar(0x00f0), QLatin1StringView("d") },  // ð
+        { QChar(0x00fe), QLatin1StringView("th") }, // þ
+        { QChar(0x0131), QLatin1StringView("i") },  // ı
+    };
+    return table;
+}
+
+const QHash<QString, QString> &tokenAliases()
+{
+    static const QHash<QString, QString> table {
+        { "st", "saint" }, { "ste", "sainte" }, { "mt", "mount" }, { "ft", "fort" }, { "&", "and" },
+    };
+    return table;
+}
+
+const QHash<QString, QString> &countryAliases()
+{
+    // normalized alias -> normalized name used by the places database
+    static const QHash<QString, QString> table {
+        { "usa", "united states" },
+        { "us", "united states" },
+        { "united states of america", "united states" },
+        { "uk", "united kingdom" },
+        { "great britain", "united kingdom" },
+        { "britain", "united kingdom" },
+        { "czechia", "czech republic" },
+        { "korea", "south korea" },
+        { "republic of korea", "south korea" },
+        { "macedonia", "north macedonia" },
+        { "ivory coast", "cote divoire" },
+        { "laos", "lao peoples democratic republic" },
+        { "brunei", "brunei darussalam" },
+        { "viet nam", "vietnam" },
+        { "russian federation", "russia" },
+        { "republic of moldova", "moldova" },
+        { "uae", "united arab emirates" },
+        { "holland", "netherlands" },
+        { "the netherlands", "netherlands" },
+        { "turkiye", "turkey" },
+        { "cape verde", "cabo verde" },
+        { "swaziland", "eswatini" },
+        { "burma", "myanmar" },
+        { "east timor", "timor leste" },
+        { "vatican", "vatican city" },
+        { "holy see", "vatican city" },
+        { "gambia", "gambia the" },
+        { "the gambia", "gambia the" },
+        { "micronesia", "micronesia federated states of" },
+        { "british virgin islands", "virgin islands british" },
+        { "bonaire", "bonaire sint eustatius and saba" },
+        { "saint helena", "saint helena ascension and tristan da cunha" },
+    };
+    return table;
+}
+
+bool isDropped(QChar c)
+{
+    switch (c.unicode()) {
+    case '\'':
+    case '`':
+    case '.':
+    case 0x2018: // ‘
+    case 0x2019: // ’
+    case 0x02bc: // ʼ
+        return true;
+    default:
+        return c.category() == QChar::Mark_NonSpacing;
+    }
+}
+
+} // namespace
+
+namespace PlaceNames {
+
+QString normalized(QStringView name)
+{
+    const QString &folded = name.toString().normalized(QString::NormalizationForm_KD).toCaseFolded();
+
+    QStringList tokens;
+    QString token;
+    auto flush = [&tokens, &token]() {
+        if (!token.isEmpty()) {
+            tokens.append(tokenAliases().value(token, token));
+            token.clear();
+        }
+    };
+
+    for (const QChar c : folded) {
+        if (isDropped(c)) {
+            continue;
+        }
+
+        if (c.isLetterOrNumber()) {
+            const auto it = transliterations().constFind(c);
+            if (it != transliterations().cend()) {
+                token.append(it.value());
+            } else {
+                token.append(c);
+            }
+        } else if (c == QLatin1Char('&')) {
+            flush();
+            token = c;
+            flush();
+        } else {
+            flush(); // any other symbol separates words
+        }
+    }
+    flush();
+
+    return tokens.join(QLatin1Char(' '));
+}
+
+QString countryKey(QStringView name)
+{
+    const QString &key = normalized(name);
+    return countryAliases().value(key, key);
+}
+
+QString cityKey(QStringView name)
+{
+    return normalized(name);
+}
+
+int distance(QStringView lhs, QStringView rhs, int limit)
+{
+    if (qAbs(lhs.size() - rhs.size()) > limit) {
+        return limit + 1;
+    }
+
+    QVarLengthArray<int, 64> previous(rhs.size() + 1);
+    QVarLengthArray<int, 64> current(rhs.size() + 1);
+    for (qsizetype j = 0; j <= rhs.size(); ++j) {
+        previous[j] = static_cast<int>(j);
+    }
+
+    for (qsizetype i = 1; i <= lhs.size(); ++i) {
+        current[0] = static_cast<int>(i);
+        int rowMin = current[0];
+        for (qsizetype j = 1; j <= rhs.size(); ++j) {
+            const int substitution = previous[j - 1] + (lhs[i - 1] == rhs[j - 1] ? 0 : 1);
+            current[j] = qMin(substitution, qMin(previous[j], current[j - 1]) + 1);
+            rowMin = qMin(rowMin, current[j]);
+        }
+
+        if (rowMin > limit) {
+            return limit + 1;
+        }
+        std::swap(previous, current);
+    }
+
+    return qMin(previous[rhs.size()], limit + 1);
+}
+
+int fuzzyLimit(qsizetype length)
+{
+    // short names are too easy to confuse
+    return length < 4 ? 0 : (length < 8 ? 1 : 2);
+}
+
+} // namespace PlaceNames
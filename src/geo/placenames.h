@@ -0,0 +1,34 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+This application is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This application is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#pragma once
+
+#include <QString>
+
+// Lookup keys for place names: case folded, without diacritics, punctuation and separators,
+// with common abbreviations expanded. Shared by the resolver and the places database generator.
+namespace PlaceNames {
+
+QString normalized(QStringView name);
+QString countryKey(QStringView name);
+QString cityKey(QStringView name);
+
+// Levenshtein distance, or limit + 1 once it's known to exceed the limit
+int distance(QStringView lhs, QStringView rhs, int limit);
+int fuzzyLimit(qsizetype length);
+
+} // namespace PlaceNames
@@ -92,6 +92,7 @@ Rectangle {
                 anchorPoint.x: image.width/2
                 anchorPoint.y: image.height
                 property placeInfo place: placeInfo
+                property string placeStats: stats
                 coordinate: place.location
 
                 sourceItem: Rectangle
@@ -147,6 +148,9 @@ Rectangle {
                                     addrStr += marker.place.country;
                                 }
 
+                                if(marker.placeStats.length !== 0)
+                                    tooltipStr = marker.placeStats + "\n" + tooltipStr
+
                                 if(addrStr.length === 0)
                                     return tooltipStr;
 
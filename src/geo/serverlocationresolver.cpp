@@ -19,6 +19,7 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html
 
 #include "app/common.h"
 #include "geo/coordinatesresolver.h"
+#include "geo/geocodinggovernor.h"
 #include "geo/serverslistmanager.h"
 #include "settings/settingsmanager.h"
 
@@ -31,7 +32,7 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html
 ServerLocationResolver::ServerLocationResolver(NordVpnWraper *nordVpn, QObject *parent)
     : QObject(parent)
     , m_listManager(new ServersListManager(nordVpn, this))
-    , m_geoResolver(new CoordinatesResolver(this))
+    , m_geoResolver(new CoordinatesResolver(GeocodingGovernor::defaultFilePath(), this))
 {
     connect(m_listManager, &ServersListManager::citiesAdded, this, &ServerLocationResolver::resolveServers);
     connect(m_listManager, &ServersListManager::citiesCount, this, [this](int total) { m_serversFound = total; });
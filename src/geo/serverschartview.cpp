@@ -18,8 +18,11 @@
 #include "serverschartview.h"
 
 #include "app/common.h"
+#include "app/connectionstats.h"
 #include "app/nordvpnwraper.h"
 #include "app/statechecker.h"
+#include "cli/clicaller.h"
+#include "cli/cliresultcache.h"
 #include "geo/flatplaceproxymodel.h"
 #include "geo/mapserversmodel.h"
 #include "serversfiltermodel.h"
@@ -30,6 +33,7 @@
 #include <QHideEvent>
 #include <QItemSelectionModel>
 #include <QLineEdit>
+#include <QMenu>
 #include <QProgressBar>
 #include <QSplitter>
 #include <QTimer>
@@ -47,6 +51,7 @@ ServersChartView::ServersChartView(NordVpnWraper *nordVpnWraper, QWidget *parent
     , m_timer(new QTimer(this))
 {
     m_serversFilterModel->setSourceModel(m_serversModel);
+    m_serversModel->setConnectionStats(m_nordVpnWraper->connectionStats());
 
     initUi();
     initConenctions();
@@ -95,6 +100,7 @@ void ServersChartView::initUi()
     m_treeView->setAlternatingRowColors(true);
     m_treeView->setHeaderHidden(true);
     m_treeView->setSortingEnabled(true);
+    m_treeView->setContextMenuPolicy(Qt::CustomContextMenu);
 
     QHBoxLayout *hBox = new QHBoxLayout;
     hBox->setAlignment(Qt::AlignCenter);
@@ -133,6 +139,8 @@ void ServersChartView::initConenctions()
             [this](const QModelIndex &current, const QModelIndex &) { onCurrentTreeItemChanged(current); });
     connect(m_treeView, &QTreeView::pressed, this, &ServersChartView::onCurrentTreeItemChanged);
     connect(m_treeView, &QTreeView::doubleClicked, this, &ServersChartView::onTreeItemDoubleclicked);
+    connect(m_treeView, &QTreeView::customContextMenuRequested, this,
+            &ServersChartView::onTreeContextMenuRequested);
     connect(m_searchBox, &QLineEdit::textChanged, this,
             [this](const QString &text) { m_serversFilterModel->setFilterRegularExpression(text); });
     connect(m_chartWidget, &MapWidget::markerDoubleclicked, this, &ServersChartView::onMarkerDoubleclicked);
@@ -188,6 +196,9 @@ void ServersChartView::requestServersList()
 
 void ServersChartView::onReloadRequested()
 {
+    if (auto cache = m_nordVpnWraper->bus()->cache())
+        cache->invalidate();
+
     handleLocationReadingPorgress(1, 150);
     requestServersList();
 }
@@ -223,6 +234,28 @@ void ServersChartView::onTreeItemDoubleclicked(const QModelIndex &current)
     requestConnection(place);
 }
 
+void ServersChartView::onTreeContextMenuRequested(const QPoint &pos)
+{
+    const QModelIndex &current = m_treeView->indexAt(pos);
+    const auto &place = current.data(MapServersModel::Roles::PlaceInfoRole).value<PlaceInfo>();
+    if (!current.isValid() || !place.ok || place.isGroup()) {
+        return;
+    }
+
+    QMenu menu(this);
+    menu.addAction(tr("Connect"), this, [this, current]() { onTreeItemDoubleclicked(current); });
+
+    const QString &country = place.country;
+    const QString &fastest = m_nordVpnWraper->connectionStats()->fastestCity(country);
+    QAction *fastestAction =
+            menu.addAction(fastest.isEmpty() ? tr("Connect to fastest in %1").arg(country)
+                                             : tr("Connect to fastest in %1 (%2)").arg(country, fastest),
+                           this, [this, country]() { m_nordVpnWraper->connectToFastest(utils::geoToNvpn(country)); });
+    fastestAction->setEnabled(!fastest.isEmpty());
+
+    menu.exec(m_treeView->viewport()->mapToGlobal(pos));
+}
+
 void ServersChartView::onMarkerDoubleclicked(const PlaceInfo &place)
 {
     requestConnection(place);
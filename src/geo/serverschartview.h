@@ -51,6 +51,7 @@ private slots:
     void onGotLocation(const PlaceInfo &place, int current, int total);
     void onCurrentTreeItemChanged(const QModelIndex &current);
     void onTreeItemDoubleclicked(const QModelIndex &current);
+    void onTreeContextMenuRequested(const QPoint &pos);
 
     void onMarkerDoubleclicked(const PlaceInfo &place);
     void saveServerLocationsCache();
@@ -21,10 +21,10 @@
 #include "actions/actionstorage.h"
 #include "app/common.h"
 #include "app/nordvpnwraper.h"
-#include "cli/clicall.h"
+#include "cli/clicaller.h"
+#include "settings/appsettings.h"
 
 #include <QTimer>
-#include <QtConcurrentRun>
 
 struct JsonConsts {
     static constexpr QLatin1String ArgGroups = QLatin1String("groups");
@@ -32,16 +32,28 @@ struct JsonConsts {
     static constexpr QLatin1String ArgCountry = QLatin1String("cities");
 };
 
+// every query and worker action is created anew, so they report the CLI metrics under a single stable id
+static const Action::Id MetricsId = QUuid::createUuidV5(QUuid(), QStringLiteral("yangl/servers-list"));
+
 ServersListManager::ServersListManager(NordVpnWraper *nordVpn, QObject *parent)
     : QObject(parent)
     , m_nordVpn(nordVpn)
+    , m_query()
+    , m_stage(Stage::Idle)
+    , m_total(0)
+    , m_parallelism(1)
+    , m_citiesQueries()
+    , m_nextQuery(0)
+    , m_nextNotify(0)
+    , m_idleWorkers()
+    , m_busyWorkers()
 {
-    connect(&m_futureWatcher, &QFutureWatcher<void>::finished, this, &ServersListManager::ready);
 }
 
 bool ServersListManager::reload()
 {
-    if (!m_futureWatcher.isRunning()) {
+    if (!isRunning()) {
+        m_stage = Stage::Groups;
         QTimer::singleShot(0, this, &ServersListManager::run);
         return true;
     }
@@ -49,28 +61,58 @@ bool ServersListManager::reload()
     return false;
 }
 
+bool ServersListManager::isRunning() const
+{
+    return m_stage != Stage::Idle;
+}
+
 /*static*/ QStringList ServersListManager::stringToServers(const QString &in)
 {
     return in.split('\n', Qt::SkipEmptyParts).toVector();
 }
 
-QStringList ServersListManager::queryList(const QStringList &args) const
+Action::Ptr ServersListManager::createQueryAction()
 {
     const Action::Ptr &action = m_nordVpn->storate()->createUserAction({});
     ActionResultViewer::unregisterAction(action.get());
     action->setTitle(tr("Servers list"));
+    action->setMetricsId(MetricsId);
     action->setForcedShow(false);
-    action->setArgs(args);
+    return action;
+}
 
-    if (auto call = action->createRequest()) {
-        call->run();
-        LOG << call->result();
-        if (call->success()) {
-            return stringToServers(call->result());
-        }
+void ServersListManager::query(Stage stage, const QStringList &args)
+{
+    if (!m_query) {
+        m_query = createQueryAction();
+        connect(m_query.get(), &Action::performed, this, &ServersListManager::onQueryFinished);
     }
 
-    return {};
+    m_stage = stage;
+    m_query->setArgs(args);
+
+    if (!m_nordVpn->bus()->performAction(m_query.get(), CLIExecutor::Lane::Bulk)) {
+        finish();
+    }
+}
+
+void ServersListManager::onQueryFinished(const Action::Id & /*id*/, const QString &result, bool ok,
+                                         const QString & /*info*/)
+{
+    LOG << result;
+
+    const QStringList &names = ok ? stringToServers(result) : QStringList();
+
+    switch (m_stage) {
+    case Stage::Groups:
+        onGroups(names);
+        break;
+    case Stage::Countries:
+        onCountries(names);
+        break;
+    default:
+        break;
+    }
 }
 
 PlaceInfo createPlace(const QString &country, const QString &city)
@@ -85,61 +127,119 @@ PlaceInfo createPlace(const QString &country, const QString &city)
     return result;
 }
 
-Places ServersListManager::queryGroups() const
+void ServersListManager::run()
+{
+    m_total = 0;
+    m_parallelism = qMax(1, AppSettings::Monitor->BulkParallelism->read().toInt());
+    m_citiesQueries.clear();
+    m_nextQuery = 0;
+    m_nextNotify = 0;
+
+    query(Stage::Groups, { JsonConsts::ArgGroups });
+}
+
+void ServersListManager::onGroups(const QStringList &names)
 {
-    const auto &names = queryList({ JsonConsts::ArgGroups });
     Places groups(names.size());
     std::transform(names.begin(), names.end(), groups.begin(),
                    [](const auto &name) { return createPlace(utils::groupsTitle(), name); });
 
-    return groups;
+    m_total = groups.size();
+    emit citiesCount(m_total);
+    notifyPlacesAdded(groups);
+
+    query(Stage::Countries, { JsonConsts::ArgCountries });
 }
 
-Places ServersListManager::queryCountries() const
+void ServersListManager::onCountries(const QStringList &names)
 {
-    const auto &names = queryList({ JsonConsts::ArgCountries });
-    Places countries(names.size());
-    std::transform(names.begin(), names.end(), countries.begin(),
-                   [](const auto &name) { return createPlace(name, {}); });
+    m_stage = Stage::Cities;
+
+    m_citiesQueries.resize(names.size());
+    for (qsizetype i = 0; i < names.size(); ++i) {
+        m_citiesQueries[i].country = names.at(i);
+    }
 
-    return countries;
+    queryCities();
 }
 
-Places ServersListManager::queryCities(const QString &country) const
+void ServersListManager::queryCities()
 {
-    const auto &names = queryList({ JsonConsts::ArgCountry, country });
-    Places sities(names.size());
-    std::transform(names.begin(), names.end(), sities.begin(),
-                   [&country](const auto &name) { return createPlace(country, name); });
+    while (m_busyWorkers.size() < m_parallelism && m_nextQuery < m_citiesQueries.size()) {
+        Action::Ptr worker;
+        if (m_idleWorkers.isEmpty()) {
+            worker = createQueryAction();
+            connect(worker.get(), &Action::performed, this, &ServersListManager::onCitiesQueryFinished);
+        } else {
+            worker = m_idleWorkers.takeLast();
+        }
+
+        const qsizetype queryId = m_nextQuery++;
+        worker->setArgs({ JsonConsts::ArgCountry, m_citiesQueries.at(queryId).country });
+        m_busyWorkers.insert(worker->id(), { worker, queryId });
+
+        if (!m_nordVpn->bus()->performAction(worker.get(), CLIExecutor::Lane::Bulk)) {
+            m_busyWorkers.remove(worker->id());
+            m_idleWorkers.append(worker);
+            onCities(queryId, {});
+        }
+    }
 
-    return sities;
+    if (m_nextNotify == m_citiesQueries.size() && m_busyWorkers.isEmpty()) {
+        finish();
+    }
 }
 
-void ServersListManager::run()
+void ServersListManager::onCitiesQueryFinished(const Action::Id &id, const QString &result, bool ok,
+                                               const QString & /*info*/)
 {
-    QFuture<void> future = QtConcurrent::run([this]() { this->runSeparated(); });
+    const auto it = m_busyWorkers.constFind(id);
+    if (it == m_busyWorkers.cend()) {
+        return;
+    }
+
+    const auto [worker, queryId] = it.value();
+    m_busyWorkers.erase(it);
+    m_idleWorkers.append(worker);
+
+    LOG << result;
+    onCities(queryId, ok ? stringToServers(result) : QStringList());
 
-    m_futureWatcher.setFuture(future);
+    queryCities();
 }
 
-void ServersListManager::runSeparated()
+void ServersListManager::onCities(qsizetype queryId, const QStringList &names)
 {
-    const auto &groups = queryGroups();
-    int total = groups.size();
-    emit citiesCount(total);
-    notifyPlacesAdded(groups);
+    CitiesQuery &entry = m_citiesQueries[queryId];
+    const QString &country = entry.country;
+
+    entry.cities.resize(names.size());
+    std::transform(names.begin(), names.end(), entry.cities.begin(),
+                   [&country](const auto &name) { return createPlace(country, name); });
+    entry.done = true;
+
+    notifyCompletedCities();
+}
 
-    QList<Places> chunks { groups };
-    const auto &countries = queryCountries();
-    for (const auto &country : countries) {
-        const auto &chunk = queryCities(country.country);
-        total += chunk.size();
-        emit citiesCount(total);
+void ServersListManager::notifyCompletedCities()
+{
+    while (m_nextNotify < m_citiesQueries.size() && m_citiesQueries.at(m_nextNotify).done) {
+        CitiesQuery &entry = m_citiesQueries[m_nextNotify++];
+
+        m_total += entry.cities.size();
+        emit citiesCount(m_total);
 
-        notifyPlacesAdded(chunk);
+        notifyPlacesAdded(entry.cities);
+        entry.cities.clear();
     }
 }
 
+void ServersListManager::finish()
+{
+    m_stage = Stage::Idle;
+    emit ready();
+}
+
 void ServersListManager::notifyPlacesAdded(const Places &cities)
 {
     Places prepared(cities.size());
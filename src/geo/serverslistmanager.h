@@ -17,9 +17,10 @@
 
 #pragma once
 
+#include "actions/action.h"
 #include "geo/placeinfo.h"
 
-#include <QFutureWatcher>
+#include <QHash>
 #include <QObject>
 
 class NordVpnWraper;
@@ -30,6 +31,7 @@ public:
     explicit ServersListManager(NordVpnWraper *nordVpn, QObject *parent = {});
 
     bool reload();
+    bool isRunning() const;
 
 signals:
     void ready();
@@ -38,18 +40,44 @@ signals:
 
 private slots:
     void run();
+    void onQueryFinished(const Action::Id &id, const QString &result, bool ok, const QString &info);
+    void onCitiesQueryFinished(const Action::Id &id, const QString &result, bool ok, const QString &info);
 
 private:
-    NordVpnWraper *m_nordVpn;
-    QFutureWatcher<void> m_futureWatcher;
-
-    Places queryGroups() const;
-    Places queryCountries() const;
-    Places queryCities(const QString &country) const;
+    enum class Stage
+    {
+        Idle,
+        Groups,
+        Countries,
+        Cities,
+    };
+
+    struct CitiesQuery {
+        QString country;
+        Places cities;
+        bool done = false;
+    };
 
-    QStringList queryList(const QStringList &args) const;
-
-    void runSeparated();
+    NordVpnWraper *m_nordVpn;
+    Action::Ptr m_query;
+    Stage m_stage;
+    int m_total;
+    int m_parallelism;
+    QList<CitiesQuery> m_citiesQueries;
+    qsizetype m_nextQuery;
+    qsizetype m_nextNotify;
+    QList<Action::Ptr> m_idleWorkers;
+    QHash<Action::Id, std::pair<Action::Ptr, qsizetype>> m_busyWorkers;
+
+    Action::Ptr createQueryAction();
+    void query(Stage stage, const QStringList &args);
+    void queryCities();
+    void finish();
+
+    void onGroups(const QStringList &names);
+    void onCountries(const QStringList &names);
+    void onCities(qsizetype queryId, const QStringList &names);
+    void notifyCompletedCities();
 
     static QStringList stringToServers(const QString &in);
 
@@ -20,6 +20,8 @@
 #include "actions/clicallresultview.h"
 #include "app/common.h"
 #include "app/statechecker.h"
+#include "app/trafficmonitor.h"
+#include "cli/cliexecutor.h"
 #include "geo/mapwidget.h"
 #include "settings/settingsmanager.h"
 
@@ -65,6 +67,21 @@ GroupMonitor::GroupMonitor()
                            new AppSetting(QString("%1/EditorGeometry").arg(localName())),
                            new AppSetting(QString("%1/LogLinesLimit").arg(localName()),
                                           CLICallResultView::MaxBlocksCountDefault),
+                           new AppSetting(QString("%1/CacheTtlGroups").arg(localName()), DefaultCacheTtlSecs),
+                           new AppSetting(QString("%1/CacheTtlCountries").arg(localName()), DefaultCacheTtlSecs),
+                           new AppSetting(QString("%1/CacheTtlCities").arg(localName()), DefaultCacheTtlSecs),
+                           new AppSetting(QString("%1/BulkParallelism").arg(localName()),
+                                          CLIExecutor::defaultLimit(CLIExecutor::Lane::Bulk)),
+                           new AppSetting(QString("%1/AdaptiveInterval").arg(localName()), false),
+                           new AppSetting(QString("%1/IntervalMin").arg(localName()),
+                                          StateChecker::DefaultMinIntervalMs),
+                           new AppSetting(QString("%1/IntervalMax").arg(localName()),
+                                          StateChecker::DefaultMaxIntervalMs),
+                           new AppSetting(QString("%1/KernelEvents").arg(localName()), true),
+                           new AppSetting(QString("%1/TrafficInterval").arg(localName()),
+                                          TrafficMonitor::DefaultIntervalMs),
+                           new AppSetting(QString("%1/TelemetryInterval").arg(localName()),
+                                          StateChecker::DefaultTelemetryIntervalMs),
                    },
                    {})
 {
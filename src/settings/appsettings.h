@@ -60,6 +60,18 @@ public:
     const AppSetting *Active = Options[2];
     const AppSetting *SettingsDialog = Options[3];
     const AppSetting *LogLinesLimit = Options[4];
+    const AppSetting *CacheTtlGroups = Options[5];
+    const AppSetting *CacheTtlCountries = Options[6];
+    const AppSetting *CacheTtlCities = Options[7];
+    const AppSetting *BulkParallelism = Options[8];
+    const AppSetting *AdaptiveInterval = Options[9];
+    const AppSetting *IntervalMin = Options[10];
+    const AppSetting *IntervalMax = Options[11];
+    const AppSetting *KernelEvents = Options[12];
+    const AppSetting *TrafficInterval = Options[13];
+    const AppSetting *TelemetryInterval = Options[14];
+
+    static constexpr int DefaultCacheTtlSecs = 6 * 60 * 60;
 
 private:
     GroupMonitor(const GroupMonitor &) = delete;
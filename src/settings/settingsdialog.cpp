@@ -30,6 +30,8 @@
 
 /*static*/ QPointer<SettingsDialog> SettingsDialog::m_instance = {};
 
+static constexpr int SecsPerMinute = 60;
+
 SettingsDialog::SettingsDialog(ActionStorage *actStorage, QWidget *parent)
     : QDialog(parent)
     , ui(new Ui::SettingsDialog)
@@ -49,6 +51,21 @@ SettingsDialog::SettingsDialog(ActionStorage *actStorage, QWidget *parent)
     ui->cbIgnoreFirstConnected->setChecked(AppSettings::Tray->IgnoreFirstConnected->read().toBool());
     ui->checkBoxMessagePlainText->setChecked(AppSettings::Tray->MessagePlainText->read().toBool());
 
+    connect(ui->checkBoxAdaptiveInterval, &QCheckBox::toggled, ui->spinBoxIntervalMin, &QSpinBox::setEnabled);
+    connect(ui->checkBoxAdaptiveInterval, &QCheckBox::toggled, ui->spinBoxIntervalMax, &QSpinBox::setEnabled);
+    ui->checkBoxAdaptiveInterval->setChecked(AppSettings::Monitor->AdaptiveInterval->read().toBool());
+    ui->spinBoxIntervalMin->setEnabled(ui->checkBoxAdaptiveInterval->isChecked());
+    ui->spinBoxIntervalMax->setEnabled(ui->checkBoxAdaptiveInterval->isChecked());
+    ui->spinBoxIntervalMin->setValue(AppSettings::Monitor->IntervalMin->read().toInt());
+    ui->spinBoxIntervalMax->setValue(AppSettings::Monitor->IntervalMax->read().toInt());
+    ui->checkBoxKernelEvents->setChecked(AppSettings::Monitor->KernelEvents->read().toBool());
+    ui->spinBoxTrafficInterval->setValue(AppSettings::Monitor->TrafficInterval->read().toInt());
+    ui->spinBoxTelemetryInterval->setValue(AppSettings::Monitor->TelemetryInterval->read().toInt());
+    ui->spinBoxBulkParallelism->setValue(AppSettings::Monitor->BulkParallelism->read().toInt());
+    ui->spinBoxCacheTtlGroups->setValue(AppSettings::Monitor->CacheTtlGroups->read().toInt() / SecsPerMinute);
+    ui->spinBoxCacheTtlCountries->setValue(AppSettings::Monitor->CacheTtlCountries->read().toInt() / SecsPerMinute);
+    ui->spinBoxCacheTtlCities->setValue(AppSettings::Monitor->CacheTtlCities->read().toInt() / SecsPerMinute);
+
     connect(ui->buttonBox, &QDialogButtonBox::accepted, this, &SettingsDialog::accept);
     connect(ui->buttonBox, &QDialogButtonBox::rejected, this, &SettingsDialog::reject);
 
@@ -132,6 +149,17 @@ bool SettingsDialog::saveMonitorSettings()
     AppSettings::Tray->MessagePlainText->write(ui->checkBoxMessagePlainText->isChecked());
     AppSettings::Monitor->LogLinesLimit->write(ui->spinBoxLogLines->value());
 
+    AppSettings::Monitor->AdaptiveInterval->write(ui->checkBoxAdaptiveInterval->isChecked());
+    AppSettings::Monitor->IntervalMin->write(ui->spinBoxIntervalMin->value());
+    AppSettings::Monitor->IntervalMax->write(qMax(ui->spinBoxIntervalMin->value(), ui->spinBoxIntervalMax->value()));
+    AppSettings::Monitor->KernelEvents->write(ui->checkBoxKernelEvents->isChecked());
+    AppSettings::Monitor->TrafficInterval->write(ui->spinBoxTrafficInterval->value());
+    AppSettings::Monitor->TelemetryInterval->write(ui->spinBoxTelemetryInterval->value());
+    AppSettings::Monitor->BulkParallelism->write(ui->spinBoxBulkParallelism->value());
+    AppSettings::Monitor->CacheTtlGroups->write(ui->spinBoxCacheTtlGroups->value() * SecsPerMinute);
+    AppSettings::Monitor->CacheTtlCountries->write(ui->spinBoxCacheTtlCountries->value() * SecsPerMinute);
+    AppSettings::Monitor->CacheTtlCities->write(ui->spinBoxCacheTtlCities->value() * SecsPerMinute);
+
     return true;
 }
 
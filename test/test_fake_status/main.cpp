@@ -1,5 +1,5 @@
 /*
-   Copyright (C) 2020 Denis Gofman - <sendevent@gmail.com>
+   Copyright (C) 2020-2025 Denis Gofman - <sendevent@gmail.com>
 
    This application is free software; you can redistribute it and/or
    modify it under the terms of the GNU Library General Public
@@ -14,9 +14,17 @@
    You should have received a copy of the GNU Lesser General Public License
    along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
 */
-
 #include <QCommandLineParser>
 #include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QRandomGenerator>
+#include <QThread>
 #include <iostream>
 #include <ostream>
 
@@ -54,13 +62,293 @@ void printDisconnected()
     printLine("Status: Disconnected");
 }
 
+namespace Catalog {
+static const QStringList Groups { "Africa_The_Middle_East_And_India",
+                                  "Asia_Pacific",
+                                  "Double_VPN",
+                                  "Europe",
+                                  "Onion_Over_VPN",
+                                  "P2P",
+                                  "Standard_VPN_Servers",
+                                  "The_Americas" };
+
+static const QList<QPair<QString, QStringList>> Places {
+    { "Finland", { "Helsinki" } },
+    { "Germany", { "Berlin", "Frankfurt", "Hamburg" } },
+    { "France", { "Marseille", "Paris", "Strasbourg" } },
+    { "Italy", { "Milan", "Palermo", "Rome" } },
+    { "Japan", { "Osaka", "Tokyo" } },
+    { "Netherlands", { "Amsterdam" } },
+    { "Switzerland", { "Zurich" } },
+    { "United_Kingdom", { "Edinburgh", "Glasgow", "London", "Manchester" } },
+    { "United_States", { "Atlanta", "Chicago", "Dallas", "Los_Angeles", "Miami", "New_York", "Seattle" } },
+};
+
+QStringList countries(int count)
+{
+    QStringList result;
+    for (int i = 0; i < count; ++i) {
+        result.append(i < Places.size() ? Places.at(i).first : QString("Country_%1").arg(i + 1, 3, 10, QChar('0')));
+    }
+    return result;
+}
+
+QStringList cities(const QString &country, int count)
+{
+    for (const auto &place : Places) {
+        if (place.first.compare(country, Qt::CaseInsensitive) == 0) {
+            return count > 0 ? place.second.mid(0, count) : place.second;
+        }
+    }
+
+    QStringList result;
+    const int total = count > 0 ? count : 1;
+    for (int i = 0; i < total; ++i) {
+        result.append(QString("%1_City_%2").arg(country).arg(i + 1));
+    }
+    return result;
+}
+} // namespace Catalog
+
+class Simulator
+{
+public:
+    int latencyMs = 0;
+    int jitterMs = 0;
+    int cityLatencyMs = 0;
+    int spinnerFrames = 0;
+    int connectTimeMs = 0;
+    QHash<QString, int> cityConnectTimeMs;
+    QStringList unreachable;
+    int countries = static_cast<int>(Catalog::Places.size());
+    int cities = 0;
+    bool stderrNoise = false;
+    QString hangCommand;
+    QString failCommand;
+    QString statePath;
+    QRandomGenerator random;
+
+    int run(const QString &command, const QStringList &args);
+
+    void delay(int extraMs = 0);
+
+private:
+    QJsonObject readState() const;
+    void writeState(const QJsonObject &state) const;
+
+    int status();
+    int connect(const QStringList &args);
+    int disconnect();
+    int printList(const QStringList &items);
+    int connectTime(const QString &city) const;
+};
+
+namespace StateKeys {
+static const QLatin1String Status { "status" };
+static const QLatin1String Country { "country" };
+static const QLatin1String City { "city" };
+static const QLatin1String Since { "since" };
+}; // namespace StateKeys
+
+void Simulator::delay(int extraMs)
+{
+    int total = latencyMs + extraMs;
+    if (jitterMs > 0) {
+        total += random.bounded(jitterMs + 1);
+    }
+
+    static const char spinner[] = { '-', '\\', '|', '/' };
+    const int frames = qMax(0, spinnerFrames);
+    const int frameMs = frames ? total / frames : 0;
+    for (int i = 0; i < frames; ++i) {
+        std::cout << '\r' << spinner[i % 4] << std::flush;
+        QThread::msleep(frameMs);
+    }
+    if (frames) {
+        std::cout << "\r  \r" << std::flush;
+    }
+
+    QThread::msleep(total - frameMs * frames);
+}
+
+QJsonObject Simulator::readState() const
+{
+    QFile in(statePath);
+    if (!in.open(QFile::ReadOnly)) {
+        return { { StateKeys::Status, "Disconnected" } };
+    }
+
+    return QJsonDocument::fromJson(in.readAll()).object();
+}
+
+void Simulator::writeState(const QJsonObject &state) const
+{
+    QFile out(statePath);
+    if (out.open(QFile::WriteOnly | QFile::Truncate)) {
+        out.write(QJsonDocument(state).toJson(QJsonDocument::Compact));
+    }
+}
+
+int Simulator::run(const QString &command, const QStringList &args)
+{
+    if (!hangCommand.isEmpty() && (hangCommand == command || hangCommand == "all")) {
+        while (true) {
+            QThread::sleep(1);
+        }
+    }
+
+    if (stderrNoise) {
+        std::cerr << "A new version of NordVPN is available! Please update the application." << std::endl;
+    }
+
+    if (!failCommand.isEmpty() && (failCommand == command || failCommand == "all")) {
+        delay();
+        std::cerr << "Whoops! Cannot reach System Daemon." << std::endl;
+        return 1;
+    }
+
+    if (command == "status") {
+        return status();
+    }
+    if (command == "connect" || command == "c") {
+        return connect(args);
+    }
+    if (command == "disconnect" || command == "d") {
+        return disconnect();
+    }
+    if (command == "countries") {
+        delay();
+        return printList(Catalog::countries(countries));
+    }
+    if (command == "cities") {
+        delay(cityLatencyMs);
+        if (args.isEmpty()) {
+            std::cerr << "The command you entered has incorrect arguments." << std::endl;
+            return 1;
+        }
+        return printList(Catalog::cities(args.first(), cities));
+    }
+    if (command == "groups") {
+        delay();
+        return printList(Catalog::Groups);
+    }
+
+    std::cerr << QString("Command '%1' doesn't exist.").arg(command).toStdString() << std::endl;
+    return 64;
+}
+
+int Simulator::status()
+{
+    delay();
+
+    QJsonObject state = readState();
+    const QString &current = state.value(StateKeys::Status).toString();
+    const qint64 since = state.value(StateKeys::Since).toInteger();
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    if (current == "Connecting" && now - since >= connectTime(state.value(StateKeys::City).toString())) {
+        state.insert(StateKeys::Status, "Connected");
+        state.insert(StateKeys::Since, now);
+        writeState(state);
+        return status();
+    }
+
+    if (current != "Connected" && current != "Connecting") {
+        printDisconnected();
+        return 0;
+    }
+
+    const QString &country = state.value(StateKeys::Country).toString();
+    const QString &city = state.value(StateKeys::City).toString();
+    const QString &host = QString("%1%2.nordvpn.com").arg(country.left(2).toLower()).arg(88);
+
+    printLine(QString("Status: %1").arg(current));
+    printLine(QString("Current server: %1").arg(host));
+    printLine(QString("Country: %1").arg(QString(country).replace('_', ' ')));
+    printLine(QString("City: %1").arg(QString(city).replace('_', ' ')));
+    printLine("Your new IP: 196.196.203.67");
+    printLine("Current technology: OpenVPN");
+    printLine("Current protocol: UDP");
+
+    if (current == "Connected") {
+        const qint64 secs = qMax<qint64>(0, (now - since) / 1000);
+        printLine(QString("Transfer: %1 KiB received, %2 KiB sent").arg(secs * 12).arg(secs * 3));
+        printLine(QString("Uptime: %1 hours %2 minutes %3 seconds")
+                          .arg(secs / 3600)
+                          .arg(secs / 60 % 60)
+                          .arg(secs % 60));
+    }
+
+    return 0;
+}
+
+int Simulator::connect(const QStringList &args)
+{
+    QStringList target(args);
+    if (!target.isEmpty() && target.first() == "-g") {
+        target.removeFirst();
+    }
+
+    const QString &country = target.value(0, Catalog::Places.first().first);
+    const QStringList &known = Catalog::cities(country, cities);
+    const QString &city = target.value(1, known.value(0));
+
+    writeState({
+            { StateKeys::Status, "Connecting" },
+            { StateKeys::Country, country },
+            { StateKeys::City, city },
+            { StateKeys::Since, QDateTime::currentMSecsSinceEpoch() },
+    });
+
+    printLine(QString("Connecting to %1 #88 (%2)").arg(country, city));
+    delay(connectTime(city));
+
+    if (unreachable.contains(city, Qt::CaseInsensitive)) {
+        writeState({ { StateKeys::Status, "Disconnected" } });
+        std::cerr << "Whoops! Connection failed. Please try again." << std::endl;
+        return 1;
+    }
+
+    writeState({
+            { StateKeys::Status, "Connected" },
+            { StateKeys::Country, country },
+            { StateKeys::City, city },
+            { StateKeys::Since, QDateTime::currentMSecsSinceEpoch() },
+    });
+
+    printLine(QString("You are connected to %1 #88 (%2)!").arg(country, city));
+    return 0;
+}
+
+int Simulator::connectTime(const QString &city) const
+{
+    return cityConnectTimeMs.value(city.toLower(), connectTimeMs);
+}
+
+int Simulator::disconnect()
+{
+    delay();
+    writeState({ { StateKeys::Status, "Disconnected" } });
+    printLine("You are disconnected from NordVPN.");
+    return 0;
+}
+
+int Simulator::printList(const QStringList &items)
+{
+    for (const auto &item : items) {
+        printLine(item);
+    }
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
     QCoreApplication a(argc, argv);
 
     QCommandLineParser parser;
     parser.setApplicationDescription(
-            "YANGL Test helper: the CLI tool to fake expected NVPN statuses and check their handling");
+            "YANGL Test helper: the CLI tool to fake NVPN CLI behaviour and check its handling.\n"
+            "Extra options could also be passed via the YANGL_FAKE_NVPN environment variable.");
     parser.addHelpOption();
     parser.addVersionOption();
 
@@ -71,14 +359,110 @@ int main(int argc, char *argv[])
     const QCommandLineOption optionDisconnected {
         { "d", "status-disconnected" }, QCoreApplication::translate("main", "Emulate \"disconnected\" output")
     };
+    const QCommandLineOption optionLatency { "latency", QCoreApplication::translate("main", "Reply after <ms>"), "ms",
+                                            "0" };
+    const QCommandLineOption optionJitter { "jitter",
+                                            QCoreApplication::translate("main", "Add random [0, <ms>] to latency"),
+                                            "ms", "0" };
+    const QCommandLineOption optionCityLatency {
+        "city-latency", QCoreApplication::translate("main", "Extra latency of the cities command"), "ms", "0"
+    };
+    const QCommandLineOption optionSpinner { "spinner",
+                                             QCoreApplication::translate("main", "Print <frames> of spinner first"),
+                                             "frames", "0" };
+    const QCommandLineOption optionStderr { "stderr-noise",
+                                            QCoreApplication::translate("main", "Print a warning to stderr") };
+    const QCommandLineOption optionHang {
+        "hang", QCoreApplication::translate("main", "Never finish the <command> (\"all\" for any)"), "command"
+    };
+    const QCommandLineOption optionFail {
+        "fail", QCoreApplication::translate("main", "Fail the <command> (\"all\" for any)"), "command"
+    };
+    const QCommandLineOption optionCountries { "countries-count",
+                                               QCoreApplication::translate("main", "Size of the countries catalog"),
+                                               "count", QString::number(Catalog::Places.size()) };
+    const QCommandLineOption optionCities { "cities-count",
+                                            QCoreApplication::translate("main", "Cities per country (0 - natural)"),
+                                            "count", "0" };
+    const QCommandLineOption optionConnectTime {
+        "connect-time", QCoreApplication::translate("main", "Time spent in \"connecting\" state"), "ms", "0"
+    };
+    const QCommandLineOption optionCityConnectTime {
+        "city-connect-time",
+        QCoreApplication::translate("main", "Per-city connect time, overrides --connect-time (<city>=<ms>,...)"),
+        "list"
+    };
+    const QCommandLineOption optionUnreachable {
+        "unreachable", QCoreApplication::translate("main", "Fail connecting to the <city> (could be repeated)"), "city"
+    };
+    const QCommandLineOption optionState {
+        "state", QCoreApplication::translate("main", "Connection state file"), "path",
+        QDir::temp().absoluteFilePath("yangl_fake_nvpn.state")
+    };
+    const QCommandLineOption optionSeed { "seed", QCoreApplication::translate("main", "Jitter random seed"), "seed",
+                                          "1" };
 
     parser.addOptions({
             optionConnecting,
             optionConnected,
             optionDisconnected,
+            optionLatency,
+            optionJitter,
+            optionCityLatency,
+            optionSpinner,
+            optionStderr,
+            optionHang,
+            optionFail,
+            optionCountries,
+            optionCities,
+            optionConnectTime,
+            optionCityConnectTime,
+            optionUnreachable,
+            optionState,
+            optionSeed,
     });
+    parser.addPositionalArgument(
+            "command", QCoreApplication::translate("main", "status|connect|disconnect|countries|cities|groups"));
+    parser.setOptionsAfterPositionalArgumentsMode(QCommandLineParser::ParseAsPositionalArguments);
 
-    parser.process(a);
+    QStringList arguments = a.arguments();
+    const QString &envOptions = qEnvironmentVariable("YANGL_FAKE_NVPN");
+    if (!envOptions.isEmpty()) {
+        arguments = arguments.mid(0, 1) + QProcess::splitCommand(envOptions) + arguments.mid(1);
+    }
+    parser.process(arguments);
+
+    Simulator simulator;
+    simulator.latencyMs = parser.value(optionLatency).toInt();
+    simulator.jitterMs = parser.value(optionJitter).toInt();
+    simulator.cityLatencyMs = parser.value(optionCityLatency).toInt();
+    simulator.spinnerFrames = parser.value(optionSpinner).toInt();
+    simulator.stderrNoise = parser.isSet(optionStderr);
+    simulator.hangCommand = parser.value(optionHang);
+    simulator.failCommand = parser.value(optionFail);
+    simulator.countries = parser.value(optionCountries).toInt();
+    simulator.cities = parser.value(optionCities).toInt();
+    simulator.connectTimeMs = parser.value(optionConnectTime).toInt();
+    for (const auto &entry : parser.value(optionCityConnectTime).split(',', Qt::SkipEmptyParts)) {
+        const QStringList &pair = entry.split('=');
+        if (pair.size() == 2) {
+            simulator.cityConnectTimeMs.insert(pair.first().trimmed().toLower(), pair.last().toInt());
+        }
+    }
+    simulator.unreachable = parser.values(optionUnreachable);
+    simulator.statePath = parser.value(optionState);
+    quint32 seed = parser.value(optionSeed).toUInt();
+    for (const auto &arg : parser.positionalArguments()) {
+        for (const QChar &c : arg) {
+            seed = seed * 31 + c.unicode();
+        }
+    }
+    simulator.random.seed(seed);
+
+    const QStringList &positional = parser.positionalArguments();
+    if (!positional.isEmpty()) {
+        return simulator.run(positional.first(), positional.mid(1));
+    }
 
     if (parser.optionNames().isEmpty()) {
         printLine(parser.helpText());
@@ -86,10 +470,13 @@ int main(int argc, char *argv[])
     }
 
     if (parser.isSet(optionConnecting)) {
+        simulator.delay();
         printConnecting();
     } else if (parser.isSet(optionConnected)) {
+        simulator.delay();
         printConnected();
     } else if (parser.isSet(optionDisconnected)) {
+        simulator.delay();
         printDisconnected();
     } else {
         return 20;
@@ -0,0 +1,252 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "app/connectionhistory.h"
+#include "app/nordvpninfo.h"
+
+#include <QBuffer>
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+
+class TestConnectionHistory : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestConnectionHistory(QObject *parent = {});
+
+private slots:
+    void test_ring_buffer();
+    void test_sample();
+    void test_recent_eviction();
+    void test_downsampling();
+    void test_bounded_memory();
+    void test_export_csv();
+    void test_export_after_reconnects();
+    void test_sparkline();
+
+private:
+    static NordVpnInfo connected(quint64 rxBytes, quint64 txBytes,
+                                 const QString &server = QStringLiteral("de1.nordvpn.com"));
+    static NordVpnInfo disconnected();
+};
+
+TestConnectionHistory::TestConnectionHistory(QObject *parent)
+    : QObject(parent)
+{
+}
+
+/*static*/ NordVpnInfo TestConnectionHistory::connected(quint64 rxBytes, quint64 txBytes, const QString &server)
+{
+    return NordVpnInfo::fromString(QStringLiteral("Status: Connected\nCurrent server: %1\n"
+                                                  "Transfer: %2 B received, %3 B sent\nUptime: 5 seconds\n")
+                                           .arg(server)
+                                           .arg(rxBytes)
+                                           .arg(txBytes));
+}
+
+/*static*/ NordVpnInfo TestConnectionHistory::disconnected()
+{
+    return NordVpnInfo::fromString(QStringLiteral("Status: Disconnected\n"));
+}
+
+void TestConnectionHistory::test_ring_buffer()
+{
+    RingBuffer<int> ring(3);
+    QVERIFY(ring.isEmpty());
+
+    int evicted(-1);
+    QVERIFY(!ring.push(1, &evicted));
+    QVERIFY(!ring.push(2, &evicted));
+    QVERIFY(!ring.push(3, &evicted));
+    QVERIFY(ring.isFull());
+    QCOMPARE(evicted, -1);
+
+    QVERIFY(ring.push(4, &evicted));
+    QCOMPARE(evicted, 1);
+    QCOMPARE(ring.size(), qsizetype(3));
+    QCOMPARE(ring.first(), 2);
+    QCOMPARE(ring.at(1), 3);
+    QCOMPARE(ring.last(), 4);
+
+    ring.clear();
+    QVERIFY(ring.isEmpty());
+    QCOMPARE(ring.capacity(), qsizetype(3));
+}
+
+void TestConnectionHistory::test_sample()
+{
+    ConnectionHistory history;
+    const ConnectionHistory::Sample &sample = history.sampleFrom(connected(100, 50), 1000);
+    QCOMPARE(sample.timestampMs, qint64(1000));
+    QCOMPARE(sample.status, NordVpnInfo::Status::Connected);
+    QCOMPARE(sample.rxBytes, quint64(100));
+    QCOMPARE(sample.txBytes, quint64(50));
+    QCOMPARE(sample.uptimeSecs, quint32(5));
+    QCOMPARE(history.serverName(sample.server), QStringLiteral("de1.nordvpn.com"));
+
+    const ConnectionHistory::Sample &empty = history.sampleFrom(disconnected(), 2000);
+    QCOMPARE(empty.status, NordVpnInfo::Status::Disconnected);
+    QCOMPARE(empty.uptimeSecs, ConnectionHistory::NoUptime);
+    QVERIFY(history.serverName(empty.server).isEmpty());
+    QCOMPARE(history.sampleFrom(connected(200, 100), 3000).server, sample.server);
+}
+
+void TestConnectionHistory::test_recent_eviction()
+{
+    ConnectionHistory history(4, 4, 10);
+    QSignalSpy spy(&history, &ConnectionHistory::appended);
+
+    for (int i = 0; i < 6; ++i) {
+        history.append(connected(i, 0), i * 1000);
+    }
+
+    QCOMPARE(spy.count(), 6);
+    QCOMPARE(history.recentSize(), qsizetype(4));
+    QCOMPARE(history.archiveSize(), qsizetype(0));
+    // two evicted samples wait in the pending bucket
+    QCOMPARE(history.size(), qsizetype(5));
+
+    QList<qint64> timestamps;
+    history.forEach([&timestamps](const ConnectionHistory::Sample &sample) { timestamps.append(sample.timestampMs); });
+    QCOMPARE(timestamps, QList<qint64>({ 1000, 2000, 3000, 4000, 5000 }));
+}
+
+void TestConnectionHistory::test_downsampling()
+{
+    ConnectionHistory history(2, 3, 3);
+
+    // 2 recent + 3 buckets of 3 evicted samples
+    for (int i = 0; i < 11; ++i) {
+        history.append(i == 4 ? disconnected() : connected(i, 0), i * 1000);
+    }
+
+    QCOMPARE(history.recentSize(), qsizetype(2));
+    QCOMPARE(history.archiveSize(), qsizetype(3));
+    QCOMPARE(history.size(), qsizetype(5));
+
+    QList<ConnectionHistory::Sample> samples;
+    history.forEach([&samples](const ConnectionHistory::Sample &sample) { samples.append(sample); });
+    QCOMPARE(samples.size(), qsizetype(5));
+
+    // each bucket keeps its newest sample
+    QCOMPARE(samples.at(0).timestampMs, qint64(2000));
+    QCOMPARE(samples.at(1).timestampMs, qint64(5000));
+    QCOMPARE(samples.at(2).timestampMs, qint64(8000));
+
+    // but a drop inside the bucket is not hidden by a later reconnect
+    QCOMPARE(samples.at(0).status, NordVpnInfo::Status::Connected);
+    QCOMPARE(samples.at(1).status, NordVpnInfo::Status::Disconnected);
+    QCOMPARE(samples.at(2).status, NordVpnInfo::Status::Connected);
+
+    history.clear();
+    QCOMPARE(history.size(), qsizetype(0));
+}
+
+void TestConnectionHistory::test_bounded_memory()
+{
+    ConnectionHistory history(16, 8, 4);
+    const qsizetype initial = history.memoryUsage();
+
+    for (int i = 0; i < 10000; ++i) {
+        history.append(connected(i * 10, i), i * 1000);
+    }
+
+    QCOMPARE(history.memoryUsage(), initial);
+    QCOMPARE(history.recentSize(), qsizetype(16));
+    QCOMPARE(history.archiveSize(), qsizetype(8));
+    QVERIFY(history.size() <= 16 + 8 + 1);
+}
+
+void TestConnectionHistory::test_export_csv()
+{
+    ConnectionHistory history(3, 2, 2);
+    QCOMPARE(history.exportCsv(nullptr), qsizetype(-1));
+
+    for (int i = 0; i < 5; ++i) {
+        history.append(connected(100 * i, 10 * i), 1700000000000 + i * 1000);
+    }
+    history.append(disconnected(), 1700000005000);
+
+    QBuffer buffer;
+    QCOMPARE(history.exportCsv(&buffer), qsizetype(-1));
+
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QCOMPARE(history.exportCsv(&buffer), history.size());
+    buffer.close();
+
+    const QList<QByteArray> &lines = buffer.data().trimmed().split('\n');
+    QCOMPARE(lines.size(), history.size() + 1);
+    QCOMPARE(lines.first(), QByteArray("timestamp,status,server,rx_bytes,tx_bytes,uptime_secs"));
+    QCOMPARE(lines.at(1), QByteArray("2023-11-14T22:13:21.000Z,Connected,de1.nordvpn.com,100,10,5"));
+    QCOMPARE(lines.last(), QByteArray("2023-11-14T22:13:25.000Z,Disconnected,,0,0,"));
+}
+
+void TestConnectionHistory::test_export_after_reconnects()
+{
+    // more servers than NordVpnInfo keeps ids for
+    static constexpr int Reconnects = 300;
+    ConnectionHistory history(Reconnects * 3, 2, 2);
+    auto serverAt = [](int i) { return QStringLiteral("fi%1.nordvpn.com").arg(i); };
+
+    qint64 timestampMs(1700000000000);
+    for (int i = 0; i < Reconnects; ++i) {
+        history.append(connected(i, 0, serverAt(i)), timestampMs += 1000);
+        history.append(connected(i + 1, 0, serverAt(i)), timestampMs += 1000);
+        history.append(disconnected(), timestampMs += 1000);
+    }
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QCOMPARE(history.exportCsv(&buffer), qsizetype(Reconnects * 3));
+    buffer.close();
+
+    const QList<QByteArray> &lines = buffer.data().trimmed().split('\n');
+    QCOMPARE(lines.size(), Reconnects * 3 + 1);
+    for (int i = 0; i < Reconnects; ++i) {
+        const QByteArray &server = serverAt(i).toUtf8();
+        QCOMPARE(lines.at(1 + i * 3).split(',').at(2), server);
+        QCOMPARE(lines.at(2 + i * 3).split(',').at(2), server);
+        QCOMPARE(lines.at(3 + i * 3).split(',').at(2), QByteArray());
+    }
+}
+
+void TestConnectionHistory::test_sparkline()
+{
+    ConnectionHistory history(8, 2, 2);
+    QVERIFY(history.sparkline(4).isEmpty());
+
+    history.append(connected(0, 0), 0);
+    QVERIFY(history.sparkline(4).isEmpty());
+
+    const QList<quint64> totals { 100, 100, 300, 1100, 1200 };
+    for (int i = 0; i < totals.size(); ++i) {
+        history.append(connected(totals.at(i), 0), (i + 1) * 1000);
+    }
+
+    QCOMPARE(history.sparkline(0), QString());
+    QCOMPARE(history.sparkline(2).size(), qsizetype(2));
+    QCOMPARE(history.sparkline(100).size(), qsizetype(5));
+    QCOMPARE(history.sparkline(5), QStringLiteral("▂▁▃█▂"));
+
+    // a counter reset does not produce a negative spike
+    history.append(connected(0, 0), 6000);
+    QCOMPARE(history.sparkline(1), QStringLiteral("▁"));
+}
+
+QTEST_MAIN(TestConnectionHistory)
+#include "testconnectionhistory.moc"
@@ -0,0 +1,335 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "actions/testaction.h"
+#include "app/connectionstats.h"
+#include "app/statechecker.h"
+#include "cli/clicaller.h"
+#include "settings/appsettings.h"
+
+#include <QFileInfo>
+#include <QObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+class TestConnectionStats : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestConnectionStats(QObject *parent = {});
+
+private slots:
+    void initTestCase();
+    void cleanup();
+
+    void test_percentile();
+    void test_success();
+    void test_failure();
+    void test_retry_and_abandon();
+    void test_timeout();
+    void test_unknown_location();
+    void test_fastest_city();
+    void test_persistence();
+    void test_simulated_cities();
+
+private:
+    QTemporaryDir m_dir;
+    QString m_app;
+
+    static NordVpnInfo state(NordVpnInfo::Status status, const QString &country = {}, const QString &city = {});
+    Action::Ptr createAction(const QStringList &args) const;
+};
+
+TestConnectionStats::TestConnectionStats(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void TestConnectionStats::initTestCase()
+{
+    AppSettings::init();
+
+    QVERIFY(m_dir.isValid());
+    m_app = QFileInfo(QString(qApp->applicationFilePath()).replace(qAppName(), "../../../../../tests/test_fake_status"))
+                    .absoluteFilePath();
+    QVERIFY(QFileInfo::exists(m_app));
+}
+
+void TestConnectionStats::cleanup()
+{
+    qunsetenv("YANGL_FAKE_NVPN");
+}
+
+/*static*/ NordVpnInfo TestConnectionStats::state(NordVpnInfo::Status status, const QString &country,
+                                                  const QString &city)
+{
+    QString text = QStringLiteral("Status: %1\n").arg(NordVpnInfo::statusToText(status));
+    if (!country.isEmpty()) {
+        text += QStringLiteral("Country: %1\nCity: %2\n").arg(country, city);
+    }
+    return NordVpnInfo::fromString(text);
+}
+
+Action::Ptr TestConnectionStats::createAction(const QStringList &args) const
+{
+    Action::Ptr action(new TestAction(Action::Flow::Custom, Action::NordVPN::Unknown));
+    action->setApp(m_app);
+    action->setArgs(args);
+    return action;
+}
+
+void TestConnectionStats::test_percentile()
+{
+    QCOMPARE(ConnectionStats::percentile({}, 0.5), qint64(-1));
+    QCOMPARE(ConnectionStats::percentile({ 7 }, 0.9), qint64(7));
+
+    const QList<qint64> samples { 500, 100, 400, 200, 300, 1000, 600, 900, 800, 700 };
+    QCOMPARE(ConnectionStats::percentile(samples, 0.5), qint64(500));
+    QCOMPARE(ConnectionStats::percentile(samples, 0.9), qint64(900));
+    QCOMPARE(ConnectionStats::percentile(samples, 1.), qint64(1000));
+    QCOMPARE(ConnectionStats::percentile(samples, 0.), qint64(100));
+}
+
+void TestConnectionStats::test_success()
+{
+    ConnectionStats stats(m_dir.filePath("success.json"));
+    QSignalSpy spy(&stats, &ConnectionStats::updated);
+
+    stats.begin("United_States", "New_York", 1000);
+    QVERIFY(stats.isPending());
+
+    stats.setState(state(NordVpnInfo::Status::Connecting, "United States", "New York"), 1500);
+    QVERIFY(stats.isPending());
+    stats.setState(state(NordVpnInfo::Status::Connected, "United States", "New York"), 3500);
+    QVERIFY(!stats.isPending());
+    QCOMPARE(spy.count(), 1);
+
+    // both the CLI and the status spelling address the same location
+    const ConnectionStats::Summary &city = stats.summary("United States", "New York");
+    QCOMPARE(city.successes, 1);
+    QCOMPARE(city.failures, 0);
+    QCOMPARE(city.p50Ms, qint64(2500));
+    QCOMPARE(city.bestMs, qint64(2500));
+    QCOMPARE(city.successRate(), 1.);
+    QCOMPARE(stats.summary("united_states", "new_york").successes, 1);
+    QCOMPARE(stats.summary("United States").successes, 1);
+    QCOMPARE(stats.size(), 1);
+    QVERIFY(!city.toString().isEmpty());
+    QVERIFY(stats.summary("Germany").isEmpty());
+    QVERIFY(stats.summary("Germany").toString().isEmpty());
+}
+
+void TestConnectionStats::test_failure()
+{
+    ConnectionStats stats(m_dir.filePath("failure.json"));
+
+    // the status may still be reported as disconnected before the CLI gets to work
+    stats.begin("Germany", "Berlin", 0);
+    stats.setState(state(NordVpnInfo::Status::Disconnected), 100);
+    QVERIFY(stats.isPending());
+
+    stats.setState(state(NordVpnInfo::Status::Connecting, "Germany", "Berlin"), 200);
+    stats.setState(state(NordVpnInfo::Status::Disconnected), 300);
+    QVERIFY(!stats.isPending());
+
+    stats.begin("Germany", "Berlin", 1000);
+    stats.fail();
+    QVERIFY(!stats.isPending());
+
+    const ConnectionStats::Summary &summary = stats.summary("Germany", "Berlin");
+    QCOMPARE(summary.failures, 2);
+    QCOMPARE(summary.successes, 0);
+    QCOMPARE(summary.p50Ms, qint64(-1));
+    QCOMPARE(summary.successRate(), 0.);
+}
+
+void TestConnectionStats::test_retry_and_abandon()
+{
+    ConnectionStats stats(m_dir.filePath("retry.json"));
+
+    stats.begin("France", "Paris", 0);
+    stats.begin("France", "Paris", 2000);
+    stats.setState(state(NordVpnInfo::Status::Connected, "France", "Paris"), 3000);
+
+    ConnectionStats::Summary summary = stats.summary("France", "Paris");
+    QCOMPARE(summary.retries, 1);
+    QCOMPARE(summary.successes, 1);
+    // measured from the first attempt
+    QCOMPARE(summary.p50Ms, qint64(3000));
+
+    stats.begin("France", "Marseille", 4000);
+    stats.begin("France", "Paris", 5000);
+    stats.setState(state(NordVpnInfo::Status::Connecting, "France", "Paris"), 5500);
+    stats.setState(state(NordVpnInfo::Status::Connected, "France", "Paris"), 6000);
+
+    QCOMPARE(stats.summary("France", "Marseille").failures, 1);
+    summary = stats.summary("France");
+    QCOMPARE(summary.successes, 2);
+    QCOMPARE(summary.failures, 1);
+    QCOMPARE(summary.attempts(), 3);
+}
+
+void TestConnectionStats::test_timeout()
+{
+    ConnectionStats stats(m_dir.filePath("timeout.json"));
+    stats.setTimeout(50);
+    QCOMPARE(stats.timeout(), 50);
+
+    stats.begin("Japan", "Tokyo", 0);
+    stats.setState(state(NordVpnInfo::Status::Connecting, "Japan", "Tokyo"), 10);
+    QTRY_VERIFY_WITH_TIMEOUT(!stats.isPending(), 1000);
+    QCOMPARE(stats.summary("Japan", "Tokyo").failures, 1);
+}
+
+void TestConnectionStats::test_unknown_location()
+{
+    ConnectionStats stats(m_dir.filePath("unknown.json"));
+
+    stats.setState(state(NordVpnInfo::Status::Connected, "Italy", "Rome"), 0);
+
+    // a generic connect while connected elsewhere waits for the new connection
+    stats.begin({}, {}, 1000);
+    stats.setState(state(NordVpnInfo::Status::Connected, "Italy", "Milan"), 1100);
+    QVERIFY(stats.isPending());
+    stats.setState(state(NordVpnInfo::Status::Connecting, "Italy", "Milan"), 1200);
+    stats.setState(state(NordVpnInfo::Status::Connected, "Italy", "Milan"), 1800);
+    QVERIFY(!stats.isPending());
+    QCOMPARE(stats.summary("Italy", "Milan").p50Ms, qint64(800));
+
+    // a country-only request is credited to the city it ended up in
+    stats.begin("Italy", {}, 2000);
+    stats.setState(state(NordVpnInfo::Status::Connecting, "Italy", "Palermo"), 2100);
+    stats.setState(state(NordVpnInfo::Status::Connected, "Italy", "Palermo"), 2400);
+    QCOMPARE(stats.summary("Italy", "Palermo").successes, 1);
+
+    // and a failed one can't be attributed at all
+    stats.begin({}, {}, 3000);
+    stats.fail();
+    QCOMPARE(stats.summary("Italy").attempts(), 2);
+}
+
+void TestConnectionStats::test_fastest_city()
+{
+    ConnectionStats stats(m_dir.filePath("fastest.json"));
+    QVERIFY(stats.fastestCity("Germany").isEmpty());
+
+    auto connectTo = [&stats](const QString &city, qint64 durationMs, bool ok) {
+        stats.begin("Germany", city, 0);
+        stats.setState(state(NordVpnInfo::Status::Connecting, "Germany", city), 1);
+        if (ok) {
+            stats.setState(state(NordVpnInfo::Status::Connected, "Germany", city), durationMs);
+        } else {
+            stats.fail();
+        }
+    };
+
+    connectTo("Berlin", 3000, true);
+    connectTo("Hamburg", 2000, true);
+    QCOMPARE(stats.fastestCity("Germany"), QString("Hamburg"));
+
+    // fast but unreliable
+    connectTo("Hamburg", 2000, false);
+    connectTo("Hamburg", 2000, false);
+    QCOMPARE(stats.fastestCity("Germany"), QString("Berlin"));
+
+    connectTo("Frankfurt", 100, false);
+    QCOMPARE(stats.fastestCity("Germany"), QString("Berlin"));
+    QVERIFY(stats.fastestCity("France").isEmpty());
+}
+
+void TestConnectionStats::test_persistence()
+{
+    const QString &path = m_dir.filePath("persistence/stats.json");
+    {
+        ConnectionStats stats(path);
+        for (int i = 0; i < ConnectionStats::MaxSamples + 10; ++i) {
+            stats.begin("Netherlands", "Amsterdam", 0);
+            stats.setState(state(NordVpnInfo::Status::Connected, "Netherlands", "Amsterdam"), i);
+        }
+        stats.begin("Switzerland", "Zurich", 0);
+        stats.fail();
+    }
+    QVERIFY(QFileInfo::exists(path));
+
+    ConnectionStats stats(path);
+    QSignalSpy spy(&stats, &ConnectionStats::updated);
+    stats.load();
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(stats.size(), 2);
+
+    const ConnectionStats::Summary &amsterdam = stats.summary("Netherlands", "Amsterdam");
+    QCOMPARE(amsterdam.successes, ConnectionStats::MaxSamples + 10);
+    // only the recent samples are kept
+    QCOMPARE(amsterdam.bestMs, qint64(10));
+    QCOMPARE(stats.summary("Switzerland", "Zurich").failures, 1);
+
+    stats.clear();
+    QCOMPARE(stats.size(), 0);
+}
+
+void TestConnectionStats::test_simulated_cities()
+{
+    qputenv("YANGL_FAKE_NVPN", QString("--state %1 --city-connect-time Berlin=100,Hamburg=1200 --unreachable Frankfurt")
+                                       .arg(m_dir.filePath("nvpn.state"))
+                                       .toUtf8());
+
+    CLICaller caller;
+    StateChecker checker(&caller, 50);
+    checker.setAdaptive(false);
+    checker.setKernelEvents(false);
+    checker.setCheckAction(createAction({ "status" }));
+
+    ConnectionStats stats(m_dir.filePath("simulated.json"));
+    connect(&checker, &StateChecker::stateChanged, &stats, &ConnectionStats::onStateChanged);
+
+    auto perform = [&caller](const Action::Ptr &action) {
+        QSignalSpy spy(action.get(), &Action::performed);
+        caller.performAction(action.get());
+        return spy.wait(CLICall::DefaultTimeoutMSecs) && spy.first().at(2).toBool();
+    };
+
+    QVERIFY(perform(createAction({ "disconnect" })));
+    checker.setActive(true);
+
+    for (const QString &city : { "Berlin", "Hamburg", "Frankfurt", "Berlin", "Hamburg" }) {
+        QTRY_COMPARE_WITH_TIMEOUT(checker.state().status(), NordVpnInfo::Status::Disconnected, 2000);
+
+        stats.begin("Germany", city, QDateTime::currentMSecsSinceEpoch());
+        if (!perform(createAction({ "c", "Germany", city }))) {
+            stats.fail();
+        }
+        QTRY_VERIFY_WITH_TIMEOUT(!stats.isPending(), 5000);
+
+        QVERIFY(perform(createAction({ "d" })));
+    }
+
+    checker.setActive(false);
+
+    const ConnectionStats::Summary &berlin = stats.summary("Germany", "Berlin");
+    const ConnectionStats::Summary &hamburg = stats.summary("Germany", "Hamburg");
+    QCOMPARE(berlin.successes, 2);
+    QCOMPARE(hamburg.successes, 2);
+    QCOMPARE(stats.summary("Germany", "Frankfurt").failures, 1);
+    QVERIFY(berlin.p50Ms < hamburg.p50Ms);
+    QVERIFY(hamburg.p50Ms >= 1200);
+    QCOMPARE(stats.summary("Germany").attempts(), 5);
+    QCOMPARE(stats.fastestCity("Germany"), QString("Berlin"));
+}
+
+QTEST_MAIN(TestConnectionStats)
+#include "testconnectionstats.moc"
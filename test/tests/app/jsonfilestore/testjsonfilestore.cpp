@@ -0,0 +1,157 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "app/common.h"
+#include "app/jsonfilestore.h"
+
+#include <QFile>
+#include <QJsonObject>
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+class TestJsonFileStore : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestJsonFileStore(QObject *parent = {});
+
+private slots:
+    void test_roundtrip();
+    void test_version_mismatch();
+    void test_debounced_save();
+    void test_discard();
+    void test_memory_only();
+
+private:
+    QTemporaryDir m_dir;
+
+    static QJsonArray entries(int count);
+};
+
+TestJsonFileStore::TestJsonFileStore(QObject *parent)
+    : QObject(parent)
+{
+}
+
+/*static*/ QJsonArray TestJsonFileStore::entries(int count)
+{
+    QJsonArray jArr;
+    for (int i = 0; i < count; ++i) {
+        jArr.append(QJsonObject { { "value", i } });
+    }
+    return jArr;
+}
+
+void TestJsonFileStore::test_roundtrip()
+{
+    const QString &path = m_dir.filePath("sub/roundtrip.json");
+
+    JsonFileStore out(path, 1);
+    out.setWriter([]() { return entries(3); });
+    out.save();
+    QVERIFY(QFile::exists(path));
+
+    const JsonFileStore in(path, 1);
+    QCOMPARE(in.read(), entries(3));
+}
+
+void TestJsonFileStore::test_version_mismatch()
+{
+    const QString &path = m_dir.filePath("version.json");
+
+    JsonFileStore out(path, 1);
+    out.setWriter([]() { return entries(2); });
+    out.save();
+
+    QVERIFY(JsonFileStore(path, 2).read().isEmpty());
+
+    QFile broken(m_dir.filePath("broken.json"));
+    QVERIFY(broken.open(QFile::WriteOnly));
+    broken.write("{ not a json");
+    broken.close();
+    QVERIFY(JsonFileStore(broken.fileName(), 1).read().isEmpty());
+}
+
+void TestJsonFileStore::test_debounced_save()
+{
+    const QString &path = m_dir.filePath("debounced.json");
+
+    int writes(0);
+    JsonFileStore store(path, 1);
+    store.setWriter([&writes]() {
+        ++writes;
+        return entries(1);
+    });
+
+    for (int i = 0; i < 5; ++i) {
+        store.scheduleSave();
+    }
+    QVERIFY(store.isSavePending());
+    QVERIFY(!QFile::exists(path));
+
+    QTRY_VERIFY(!store.isSavePending());
+    QCOMPARE(writes, 1);
+    QVERIFY(QFile::exists(path));
+
+    // each change postpones the save
+    for (int i = 0; i < 4; ++i) {
+        store.scheduleSave();
+        QTest::qWait(utils::oneSecondMs() / 2);
+        QCOMPARE(writes, 1);
+    }
+    QTRY_COMPARE(writes, 2);
+
+    store.scheduleSave();
+    store.flush();
+    QVERIFY(!store.isSavePending());
+    QCOMPARE(writes, 3);
+}
+
+void TestJsonFileStore::test_discard()
+{
+    const QString &path = m_dir.filePath("discard.json");
+
+    JsonFileStore store(path, 1);
+    store.setWriter([]() { return entries(1); });
+    store.save();
+    QVERIFY(QFile::exists(path));
+
+    store.scheduleSave();
+    store.discard();
+    QVERIFY(!store.isSavePending());
+    QVERIFY(!QFile::exists(path));
+}
+
+void TestJsonFileStore::test_memory_only()
+{
+    int writes(0);
+    JsonFileStore store({}, 1);
+    store.setWriter([&writes]() {
+        ++writes;
+        return entries(1);
+    });
+
+    store.scheduleSave();
+    QVERIFY(!store.isSavePending());
+    store.save();
+    QCOMPARE(writes, 0);
+    QVERIFY(store.read().isEmpty());
+}
+
+QTEST_MAIN(TestJsonFileStore)
+#include "testjsonfilestore.moc"
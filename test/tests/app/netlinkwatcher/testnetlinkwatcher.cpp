@@ -0,0 +1,221 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "app/netlinkwatcher.h"
+
+#include <QObject>
+#include <QSignalSpy>
+#include <QTest>
+
+#ifdef Q_OS_LINUX
+#include <cstring>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#endif
+
+class TestNetlinkWatcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestNetlinkWatcher(QObject *parent = {});
+
+private slots:
+    void init();
+
+    void test_start_stop();
+    void test_link_events();
+    void test_unrelated_interface();
+    void test_address_by_cached_index();
+    void test_burst_debounced();
+    void test_prefixes();
+
+private:
+    static QByteArray linkMessage(quint16 type, int index, const QByteArray &name);
+    static QByteArray addressMessage(quint16 type, int index, const QByteArray &label);
+};
+
+TestNetlinkWatcher::TestNetlinkWatcher(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void TestNetlinkWatcher::init()
+{
+    if (!NetlinkWatcher::isSupported()) {
+        QSKIP("rtnetlink is Linux only");
+    }
+}
+
+/*static*/ QByteArray TestNetlinkWatcher::linkMessage(quint16 type, int index, const QByteArray &name)
+{
+    QByteArray msg;
+#ifdef Q_OS_LINUX
+    const int attrSize = name.isEmpty() ? 0 : RTA_SPACE(name.size() + 1);
+    msg.fill(0, NLMSG_SPACE(sizeof(ifinfomsg)) + attrSize);
+
+    auto *header = reinterpret_cast<nlmsghdr *>(msg.data());
+    header->nlmsg_len = msg.size();
+    header->nlmsg_type = type;
+
+    auto *info = static_cast<ifinfomsg *>(NLMSG_DATA(header));
+    info->ifi_index = index;
+
+    if (attrSize) {
+        auto *attr = IFLA_RTA(info);
+        attr->rta_type = IFLA_IFNAME;
+        attr->rta_len = RTA_LENGTH(name.size() + 1);
+        std::memcpy(RTA_DATA(attr), name.constData(), name.size());
+    }
+#else
+    Q_UNUSED(type);
+    Q_UNUSED(index);
+    Q_UNUSED(name);
+#endif
+    return msg;
+}
+
+/*static*/ QByteArray TestNetlinkWatcher::addressMessage(quint16 type, int index, const QByteArray &label)
+{
+    QByteArray msg;
+#ifdef Q_OS_LINUX
+    const int attrSize = label.isEmpty() ? 0 : RTA_SPACE(label.size() + 1);
+    msg.fill(0, NLMSG_SPACE(sizeof(ifaddrmsg)) + attrSize);
+
+    auto *header = reinterpret_cast<nlmsghdr *>(msg.data());
+    header->nlmsg_len = msg.size();
+    header->nlmsg_type = type;
+
+    auto *info = static_cast<ifaddrmsg *>(NLMSG_DATA(header));
+    info->ifa_index = index;
+
+    if (attrSize) {
+        auto *attr = IFA_RTA(info);
+        attr->rta_type = IFA_LABEL;
+        attr->rta_len = RTA_LENGTH(label.size() + 1);
+        std::memcpy(RTA_DATA(attr), label.constData(), label.size());
+    }
+#else
+    Q_UNUSED(type);
+    Q_UNUSED(index);
+    Q_UNUSED(label);
+#endif
+    return msg;
+}
+
+void TestNetlinkWatcher::test_start_stop()
+{
+    NetlinkWatcher watcher;
+    QCOMPARE(watcher.isRunning(), false);
+
+    QVERIFY(watcher.start());
+    QCOMPARE(watcher.isRunning(), true);
+    QVERIFY(watcher.start());
+
+    watcher.stop();
+    QCOMPARE(watcher.isRunning(), false);
+}
+
+void TestNetlinkWatcher::test_link_events()
+{
+#ifdef Q_OS_LINUX
+    NetlinkWatcher watcher;
+    QSignalSpy spyInterface(&watcher, &NetlinkWatcher::interfaceChanged);
+    QSignalSpy spyChanged(&watcher, &NetlinkWatcher::changed);
+
+    QCOMPARE(watcher.processMessages(linkMessage(RTM_NEWLINK, 7, "nordlynx")), 1);
+    QCOMPARE(spyInterface.count(), 1);
+    QCOMPARE(spyInterface.takeFirst().at(0).toString(), QStringLiteral("nordlynx"));
+    QVERIFY(spyChanged.wait());
+    QCOMPARE(spyChanged.count(), 1);
+
+    QCOMPARE(watcher.processMessages(linkMessage(RTM_DELLINK, 7, "nordlynx")), 1);
+    QVERIFY(spyChanged.wait());
+    QCOMPARE(spyChanged.count(), 2);
+#endif
+}
+
+void TestNetlinkWatcher::test_unrelated_interface()
+{
+#ifdef Q_OS_LINUX
+    NetlinkWatcher watcher;
+    watcher.setDebounce(0);
+    QSignalSpy spyChanged(&watcher, &NetlinkWatcher::changed);
+
+    QCOMPARE(watcher.processMessages(linkMessage(RTM_NEWLINK, 2, "eth0")), 0);
+    QCOMPARE(watcher.processMessages(addressMessage(RTM_NEWADDR, 2, "eth0")), 0);
+    QCOMPARE(watcher.processMessages(linkMessage(RTM_NEWLINK, 3, "tun0")), 0);
+    QCOMPARE(watcher.processMessages(linkMessage(RTM_NEWLINK, 4, "wg0")), 0);
+    QCOMPARE(watcher.processMessages(QByteArray("garbage")), 0);
+    QCOMPARE(watcher.processMessages({}), 0);
+
+    QTest::qWait(NetlinkWatcher::DefaultDebounceMs);
+    QCOMPARE(spyChanged.count(), 0);
+#endif
+}
+
+void TestNetlinkWatcher::test_address_by_cached_index()
+{
+#ifdef Q_OS_LINUX
+    NetlinkWatcher watcher;
+    QSignalSpy spyInterface(&watcher, &NetlinkWatcher::interfaceChanged);
+
+    QCOMPARE(watcher.processMessages(addressMessage(RTM_NEWADDR, 12345, {})), 0);
+
+    QCOMPARE(watcher.processMessages(linkMessage(RTM_NEWLINK, 12345, "nordtun")), 1);
+    QCOMPARE(watcher.processMessages(addressMessage(RTM_NEWADDR, 12345, {})), 1);
+    QCOMPARE(watcher.processMessages(addressMessage(RTM_DELADDR, 12345, {})), 1);
+    QCOMPARE(watcher.processMessages(linkMessage(RTM_DELLINK, 12345, {})), 1);
+    QCOMPARE(watcher.processMessages(addressMessage(RTM_DELADDR, 12345, {})), 0);
+
+    QCOMPARE(spyInterface.count(), 4);
+    for (const auto &args : spyInterface) {
+        QCOMPARE(args.at(0).toString(), QStringLiteral("nordtun"));
+    }
+#endif
+}
+
+void TestNetlinkWatcher::test_burst_debounced()
+{
+#ifdef Q_OS_LINUX
+    NetlinkWatcher watcher;
+    QSignalSpy spyChanged(&watcher, &NetlinkWatcher::changed);
+
+    const QByteArray burst = linkMessage(RTM_NEWLINK, 7, "nordlynx") + addressMessage(RTM_NEWADDR, 7, "nordlynx")
+            + linkMessage(RTM_NEWLINK, 2, "eth0") + addressMessage(RTM_NEWADDR, 7, {});
+    QCOMPARE(watcher.processMessages(burst), 3);
+    QCOMPARE(watcher.processMessages(linkMessage(RTM_NEWLINK, 8, "nordtun")), 1);
+
+    QVERIFY(spyChanged.wait());
+    QTest::qWait(watcher.debounce() * 2);
+    QCOMPARE(spyChanged.count(), 1);
+#endif
+}
+
+void TestNetlinkWatcher::test_prefixes()
+{
+#ifdef Q_OS_LINUX
+    NetlinkWatcher watcher;
+    QCOMPARE(watcher.interfacePrefixes(), NetlinkWatcher::DefaultInterfacePrefixes);
+
+    watcher.setInterfacePrefixes({ QStringLiteral("eth") });
+    QCOMPARE(watcher.processMessages(linkMessage(RTM_NEWLINK, 7, "nordlynx")), 0);
+    QCOMPARE(watcher.processMessages(linkMessage(RTM_NEWLINK, 2, "eth0")), 1);
+#endif
+}
+
+QTEST_MAIN(TestNetlinkWatcher)
+#include "testnetlinkwatcher.moc"
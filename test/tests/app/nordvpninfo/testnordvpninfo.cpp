@@ -0,0 +1,348 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "app/nordvpninfo.h"
+
+#include <QFileInfo>
+#include <QLocale>
+#include <QMap>
+#include <QObject>
+#include <QProcess>
+#include <QTest>
+#include <type_traits>
+
+class TestNordVpnInfo : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestNordVpnInfo(QObject *parent = {});
+
+private slots:
+    void initTestCase();
+
+    void test_parse_data();
+    void test_parse();
+    void test_parse_matches_legacy_data();
+    void test_parse_matches_legacy();
+    void test_parseUptime_data();
+    void test_parseUptime();
+    void test_textToStatus();
+    void test_uptime_duration_data();
+    void test_uptime_duration();
+    void test_traffic_bytes();
+    void test_compact();
+    void test_pool_bounded();
+    void test_unexpected_lines();
+
+    void benchmark_parse_data();
+    void benchmark_parse();
+    void benchmark_parse_legacy_data();
+    void benchmark_parse_legacy();
+
+private:
+    QHash<QString, QString> m_outputs;
+
+    void addOutputRows() const;
+    static QMap<QString, QString> legacyParse(const QString &text);
+};
+
+TestNordVpnInfo::TestNordVpnInfo(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void TestNordVpnInfo::initTestCase()
+{
+    const QFileInfo fakeStatusApp(
+            QString(qApp->applicationFilePath()).replace(qAppName(), "../../../../../tests/test_fake_status"));
+    QVERIFY(fakeStatusApp.exists());
+
+    for (const QString &arg : { QStringLiteral("-i"), QStringLiteral("-e"), QStringLiteral("-d") }) {
+        QProcess proc;
+        proc.start(fakeStatusApp.absoluteFilePath(), { arg });
+        QVERIFY(proc.waitForFinished());
+        m_outputs.insert(arg, QString::fromUtf8(proc.readAllStandardOutput()));
+        QVERIFY(!m_outputs.value(arg).isEmpty());
+    }
+}
+
+void TestNordVpnInfo::addOutputRows() const
+{
+    QTest::addColumn<QString>("text");
+
+    QTest::newRow("connecting") << m_outputs.value("-i");
+    QTest::newRow("connected") << m_outputs.value("-e");
+    QTest::newRow("disconnected") << m_outputs.value("-d");
+}
+
+void TestNordVpnInfo::test_parse_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<NordVpnInfo::Status>("status");
+    QTest::addColumn<QString>("country");
+    QTest::addColumn<QString>("city");
+
+    const QString finland = QStringLiteral("Finland");
+    const QString helsinki = QStringLiteral("Helsinki");
+    QTest::newRow("connecting") << m_outputs.value("-i") << NordVpnInfo::Status::Connecting << finland << helsinki;
+    QTest::newRow("connected") << m_outputs.value("-e") << NordVpnInfo::Status::Connected << finland << helsinki;
+    QTest::newRow("disconnected") << m_outputs.value("-d") << NordVpnInfo::Status::Disconnected << QString()
+                                  << QString();
+}
+
+void TestNordVpnInfo::test_parse()
+{
+    QFETCH(QString, text);
+    QFETCH(NordVpnInfo::Status, status);
+    QFETCH(QString, country);
+    QFETCH(QString, city);
+
+    const NordVpnInfo &info = NordVpnInfo::fromString(text);
+    QCOMPARE(info.status(), status);
+    QCOMPARE(info.country(), country);
+    QCOMPARE(info.city(), city);
+}
+
+void TestNordVpnInfo::test_parse_matches_legacy_data()
+{
+    addOutputRows();
+
+    QTest::newRow("crlf") << QString(m_outputs.value("-e")).replace("\n", "\r\n");
+    QTest::newRow("padded") << QStringLiteral("  Status :  Connected \n\n Country:  United   States \n"
+                                              "Transfer: 12  MiB received, 3 KiB sent\nUptime: 1 day 2 hours 3 "
+                                              "minutes 4 seconds\n");
+    QTest::newRow("empty") << QString();
+}
+
+void TestNordVpnInfo::test_parse_matches_legacy()
+{
+    QFETCH(QString, text);
+
+    const NordVpnInfo &info = NordVpnInfo::fromString(text);
+    const QMap<QString, QString> &legacy = legacyParse(text);
+
+    QCOMPARE(info.status(), NordVpnInfo::textToStatus(legacy.value("Status")));
+    QCOMPARE(info.country(), legacy.value("Country"));
+    QCOMPARE(info.city(), legacy.value("City"));
+
+    if (info.status() == NordVpnInfo::Status::Connected || info.status() == NordVpnInfo::Status::Connecting) {
+        const QString &html = info.toString();
+        for (auto it = legacy.cbegin(); it != legacy.cend(); ++it) {
+            // traffic and uptime are kept numeric and formatted differently
+            if (it.key() != QLatin1String("Transfer") && it.key() != QLatin1String("Uptime")) {
+                QVERIFY2(html.contains(it.value()), qPrintable(it.value()));
+            }
+        }
+    }
+
+    QCOMPARE(info.hasUptime(), legacy.contains("Uptime"));
+    QCOMPARE(info.trafficSource() == NordVpnInfo::TrafficSource::Cli, legacy.contains("Transfer"));
+}
+
+void TestNordVpnInfo::test_parseUptime_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<QString>("uptime");
+
+    QTest::newRow("empty") << QString() << QString();
+    QTest::newRow("seconds") << QStringLiteral("5 seconds") << QStringLiteral("00:05");
+    QTest::newRow("hms") << QStringLiteral("3 hours 24 minutes 5 seconds") << QStringLiteral("00:03:24:05");
+    QTest::newRow("days") << QStringLiteral("1 day 2 hours 3 minutes 4 seconds") << QStringLiteral("001:02:03:04");
+    QTest::newRow("dangling") << QStringLiteral("7 minutes 12") << QStringLiteral("00:07");
+}
+
+void TestNordVpnInfo::test_parseUptime()
+{
+    QFETCH(QString, text);
+    QFETCH(QString, uptime);
+
+    QCOMPARE(NordVpnInfo::parseUptime(text), uptime);
+}
+
+void TestNordVpnInfo::test_textToStatus()
+{
+    QCOMPARE(NordVpnInfo::textToStatus(QStringLiteral("Connected")), NordVpnInfo::Status::Connected);
+    QCOMPARE(NordVpnInfo::textToStatus(QStringLiteral("Disconnecting")), NordVpnInfo::Status::Disconnecting);
+    QCOMPARE(NordVpnInfo::textToStatus(QStringLiteral(" Connecting ")), NordVpnInfo::Status::Connecting);
+    QCOMPARE(NordVpnInfo::textToStatus(QStringLiteral("connected")), NordVpnInfo::Status::Unknown);
+    QCOMPARE(NordVpnInfo::textToStatus(QString()), NordVpnInfo::Status::Unknown);
+}
+
+void TestNordVpnInfo::test_uptime_duration_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<qint64>("seconds");
+    QTest::addColumn<QString>("formatted");
+
+    QTest::newRow("empty") << QString() << qint64(-1) << QString();
+    QTest::newRow("seconds") << QStringLiteral("5 seconds") << qint64(5) << QStringLiteral("00:00:00:05");
+    QTest::newRow("hms") << QStringLiteral("3 hours 24 minutes 5 seconds") << qint64(3 * 3600 + 24 * 60 + 5)
+                         << QStringLiteral("00:03:24:05");
+    QTest::newRow("days") << QStringLiteral("1 day 2 hours 3 minutes 4 seconds")
+                          << qint64(86400 + 2 * 3600 + 3 * 60 + 4) << QStringLiteral("001:02:03:04");
+    QTest::newRow("dangling") << QStringLiteral("7 minutes 12") << qint64(7 * 60) << QStringLiteral("00:00:07:00");
+}
+
+void TestNordVpnInfo::test_uptime_duration()
+{
+    QFETCH(QString, text);
+    QFETCH(qint64, seconds);
+    QFETCH(QString, formatted);
+
+    const NordVpnInfo::Uptime uptime = NordVpnInfo::parseUptimeDuration(text);
+    QCOMPARE(qint64(uptime.count()), seconds);
+    QCOMPARE(NordVpnInfo::formatUptime(uptime), formatted);
+}
+
+void TestNordVpnInfo::test_traffic_bytes()
+{
+    quint64 rx(0), tx(0);
+    QVERIFY(NordVpnInfo::parseTraffic(u"0.97 MiB received, 452.22 KiB sent", rx, tx));
+    QCOMPARE(rx, quint64(qRound64(0.97 * 1024 * 1024)));
+    QCOMPARE(tx, quint64(qRound64(452.22 * 1024)));
+
+    QVERIFY(NordVpnInfo::parseTraffic(u"12 B received, 1.5 GiB sent", rx, tx));
+    QCOMPARE(rx, quint64(12));
+    QCOMPARE(tx, quint64(qRound64(1.5 * 1024 * 1024 * 1024)));
+
+    QVERIFY(!NordVpnInfo::parseTraffic(u"nothing here", rx, tx));
+
+    const NordVpnInfo &info = NordVpnInfo::fromString(m_outputs.value("-e"));
+    QCOMPARE(info.trafficSource(), NordVpnInfo::TrafficSource::Cli);
+    QCOMPARE(info.rxBytes(), quint64(qRound64(0.97 * 1024 * 1024)));
+    const QLocale locale;
+    QCOMPARE(info.traffic(),
+             QStringLiteral("%1 ↓, %2 ↑")
+                     .arg(locale.formattedDataSize(qint64(info.rxBytes())),
+                          locale.formattedDataSize(qint64(info.txBytes()))));
+}
+
+void TestNordVpnInfo::test_compact()
+{
+    QVERIFY(sizeof(NordVpnInfo) <= 64);
+    QVERIFY(std::is_trivially_copyable_v<NordVpnInfo>);
+
+    const NordVpnInfo &first = NordVpnInfo::fromString(m_outputs.value("-e"));
+    const qsizetype interned = NordVpnInfo::internedCount();
+    const NordVpnInfo &second = NordVpnInfo::fromString(m_outputs.value("-i"));
+    QCOMPARE(NordVpnInfo::internedCount(), interned);
+
+    QVERIFY(first.sameStructure(second) == false);
+    QCOMPARE(first.server(), second.server());
+    QCOMPARE(first.country(), QStringLiteral("Finland"));
+    QCOMPARE(first.ip(), QStringLiteral("196.196.203.67"));
+    QCOMPARE(first.technology(), QStringLiteral("OpenVPN"));
+    QCOMPARE(first.protocol(), QStringLiteral("UDP"));
+    QCOMPARE(first.uptime(), std::chrono::seconds(3 * 3600 + 24 * 60 + 5));
+}
+
+void TestNordVpnInfo::test_pool_bounded()
+{
+    auto connectedTo = [](int server) {
+        return NordVpnInfo::fromString(QStringLiteral("Status: Connected\nCurrent server: fi%1.nordvpn.com\n"
+                                                      "Country: Finland\nYour new IP: 10.0.%2.%3\n")
+                                               .arg(server)
+                                               .arg(server / 256)
+                                               .arg(server % 256));
+    };
+
+    const NordVpnInfo &first = connectedTo(0);
+    QCOMPARE(NordVpnInfo::serverName(first.serverId()), QStringLiteral("fi0.nordvpn.com"));
+
+    const qsizetype interned = NordVpnInfo::internedCount();
+    for (int i = 1; i < 1000; ++i) {
+        connectedTo(i);
+    }
+
+    // servers and addresses are kept for the recent connections only, the catalogue names once
+    QVERIFY(NordVpnInfo::internedCount() <= interned + 256);
+    QVERIFY(NordVpnInfo::serverName(first.serverId()).isEmpty());
+    QVERIFY(first.server().isEmpty());
+    QCOMPARE(first.country(), QStringLiteral("Finland"));
+    QCOMPARE(connectedTo(999).server(), QStringLiteral("fi999.nordvpn.com"));
+}
+
+void TestNordVpnInfo::test_unexpected_lines()
+{
+    const QString text = QStringLiteral("A new version of NordVPN is available\nStatus: Connected\n"
+                                        "Your new IP: 2001:db8::1\nCity: Helsinki\n");
+
+    const NordVpnInfo &info = NordVpnInfo::fromString(text);
+    QCOMPARE(info.status(), NordVpnInfo::Status::Connected);
+    QCOMPARE(info.city(), QStringLiteral("Helsinki"));
+}
+
+void TestNordVpnInfo::benchmark_parse_data()
+{
+    addOutputRows();
+}
+
+void TestNordVpnInfo::benchmark_parse()
+{
+    QFETCH(QString, text);
+
+    NordVpnInfo info;
+    QBENCHMARK {
+        info = NordVpnInfo::fromString(text);
+    }
+    QVERIFY(info.status() != NordVpnInfo::Status::Unknown);
+}
+
+void TestNordVpnInfo::benchmark_parse_legacy_data()
+{
+    addOutputRows();
+}
+
+void TestNordVpnInfo::benchmark_parse_legacy()
+{
+    QFETCH(QString, text);
+
+    QMap<QString, QString> fields;
+    QBENCHMARK {
+        fields = legacyParse(text);
+    }
+    QVERIFY(fields.contains("Status"));
+}
+
+/*static*/ QMap<QString, QString> TestNordVpnInfo::legacyParse(const QString &text)
+{
+    // The split()/replace() based parser that fromString() used to be, kept as a reference and a baseline.
+    QMap<QString, QString> fields;
+
+    const QStringList &pairs = text.split('\n', Qt::SkipEmptyParts);
+    for (const QString &line : pairs) {
+        const QStringList &pair = line.split(':', Qt::SkipEmptyParts);
+        if (pair.size() != 2) {
+            continue;
+        }
+
+        const QString &name = pair.first().simplified();
+        QString value = pair.last().simplified();
+        if (name == QStringLiteral("Transfer")) {
+            value.replace(QStringLiteral("received"), QStringLiteral("↓"));
+            value.replace(QStringLiteral("sent"), QStringLiteral("↑"));
+        } else if (name == QStringLiteral("Uptime")) {
+            value = NordVpnInfo::parseUptime(value);
+        }
+        fields.insert(name, value);
+    }
+
+    return fields;
+}
+
+QTEST_MAIN(TestNordVpnInfo)
+#include "testnordvpninfo.moc"
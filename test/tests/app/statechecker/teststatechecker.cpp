@@ -41,6 +41,10 @@ private slots:
     void test_active();
     void test_interval();
     void test_check_status_change();
+    void test_adaptive_interval();
+    void test_telemetry_throttled();
+    void test_snapshot_sequence();
+    void test_fingerprint_fast_path();
 
 private:
     const std::unique_ptr<CLICaller> m_caller;
@@ -183,5 +187,184 @@ void TestStateChecker::test_check_status_change()
     test_check(NordVpnInfo::Status::Disconnected);
 }
 
+void TestStateChecker::test_adaptive_interval()
+{
+    static constexpr int minInterval = 20;
+    static constexpr int maxInterval = 160;
+
+    const Action::Ptr &action = m_storage->action(Action::NordVPN::CheckStatus);
+    action->setArgs({ "--status-disconnected" });
+
+    m_checker->setIntervalBounds(maxInterval, minInterval);
+    QCOMPARE(m_checker->minInterval(), maxInterval);
+    QCOMPARE(m_checker->maxInterval(), maxInterval);
+
+    m_checker->setIntervalBounds(minInterval, maxInterval);
+    QCOMPARE(m_checker->minInterval(), minInterval);
+    QCOMPARE(m_checker->maxInterval(), maxInterval);
+
+    m_checker->setAdaptive(true);
+    QVERIFY(m_checker->isAdaptive());
+    QCOMPARE(m_checker->currentInterval(), minInterval);
+
+    m_checker->setActive(true);
+
+    // unchanged state backs off up to the upper bound
+    QTRY_COMPARE_WITH_TIMEOUT(m_checker->currentInterval(), maxInterval, CLICall::DefaultTimeoutMSecs);
+
+    // user action snaps back to the lower bound
+    m_checker->boost();
+    QCOMPARE(m_checker->currentInterval(), minInterval);
+    QTRY_COMPARE_WITH_TIMEOUT(m_checker->currentInterval(), maxInterval, CLICall::DefaultTimeoutMSecs);
+
+    // transitional state keeps polling fast
+    action->setArgs({ "--status-connecting" });
+    QTRY_COMPARE_WITH_TIMEOUT(m_checker->state().status(), NordVpnInfo::Status::Connecting,
+                              CLICall::DefaultTimeoutMSecs);
+    QCOMPARE(m_checker->currentInterval(), minInterval);
+    QTest::qWait(maxInterval);
+    QCOMPARE(m_checker->currentInterval(), minInterval);
+
+    m_checker->setActive(false);
+    m_checker->setAdaptive(false);
+    QCOMPARE(m_checker->currentInterval(), m_checker->interval());
+}
+
+void TestStateChecker::test_telemetry_throttled()
+{
+    static constexpr int telemetryInterval = 200;
+    m_checker->setTrafficInterval(0); // keep host interfaces out of the picture
+    m_checker->setTelemetryInterval(telemetryInterval);
+    QCOMPARE(m_checker->telemetryInterval(), telemetryInterval);
+
+    NordVpnInfo state = NordVpnInfo::fromString(QStringLiteral("Status: Connected\nCountry: Finland\nCity: Helsinki\n"));
+    m_checker->setState(state);
+    QCOMPARE(m_checker->state().status(), NordVpnInfo::Status::Connected);
+
+    QSignalSpy spyState(m_checker.get(), &StateChecker::stateChanged);
+    QSignalSpy spyStatus(m_checker.get(), &StateChecker::statusChanged);
+    QSignalSpy spyTelemetry(m_checker.get(), &StateChecker::telemetryChanged);
+
+    // a structural change has just been published, so the first tick is deferred
+    for (int i = 1; i <= 10; ++i) {
+        state.setTrafficCounters(i * 1024, i * 512, 1024., 512.);
+        m_checker->setState(state);
+    }
+
+    QCOMPARE(spyState.count(), 0);
+    QCOMPARE(spyStatus.count(), 0);
+    QCOMPARE(spyTelemetry.count(), 0);
+    QCOMPARE(m_checker->state(), state);
+
+    QVERIFY(spyTelemetry.wait(telemetryInterval * 5));
+    QCOMPARE(spyTelemetry.count(), 1);
+    QCOMPARE(spyTelemetry.takeFirst().at(0).value<NordVpnInfo>(), state);
+
+    // structural changes bypass the throttling
+    state.setStatus(NordVpnInfo::Status::Disconnecting);
+    m_checker->setState(state);
+    QCOMPARE(spyState.count(), 1);
+    QCOMPARE(spyStatus.count(), 1);
+    QCOMPARE(spyTelemetry.count(), 0);
+
+    m_checker->setTelemetryInterval(0);
+    state.setTrafficCounters(1, 1, 0., 0.);
+    m_checker->setState(state);
+    QCOMPARE(spyTelemetry.count(), 1);
+
+    m_checker->setTelemetryInterval(StateChecker::DefaultTelemetryIntervalMs);
+    m_checker->setTrafficInterval(TrafficMonitor::DefaultIntervalMs);
+    m_checker->setStatus(NordVpnInfo::Status::Unknown);
+}
+
+void TestStateChecker::test_snapshot_sequence()
+{
+    auto makeSnapshot = [](quint64 sequence, const QString &text) {
+        auto snapshot = std::make_shared<StateChecker::Snapshot>();
+        snapshot->sequence = sequence;
+        snapshot->info = NordVpnInfo::fromString(text);
+        return snapshot;
+    };
+
+    QSignalSpy spyStatus(m_checker.get(), &StateChecker::statusChanged);
+
+    const quint64 base = m_checker->m_sequence;
+    m_checker->m_sequence = base + 2;
+
+    QVERIFY(StateChecker::publish(*m_checker->m_published,
+                                  makeSnapshot(base + 2, QStringLiteral("Status: Disconnecting\n"))));
+    QVERIFY(!StateChecker::publish(*m_checker->m_published,
+                                   makeSnapshot(base + 1, QStringLiteral("Status: Connected\n"))));
+    QVERIFY(!StateChecker::publish(*m_checker->m_published,
+                                   makeSnapshot(base + 2, QStringLiteral("Status: Connected\n"))));
+    QCOMPARE(m_checker->snapshot()->sequence, base + 2);
+
+    m_checker->deliverSnapshot();
+    QCOMPARE(m_checker->state().status(), NordVpnInfo::Status::Disconnecting);
+    QCOMPARE(spyStatus.count(), 1);
+
+    // already delivered, nothing to re-emit
+    m_checker->deliverSnapshot();
+    QCOMPARE(spyStatus.count(), 1);
+
+    // a real query gets the next sequence number and wins
+    const Action::Ptr &action = m_storage->action(Action::NordVPN::CheckStatus);
+    action->setArgs({ "--status-disconnected" });
+    m_checker->check();
+    QTRY_COMPARE_WITH_TIMEOUT(m_checker->state().status(), NordVpnInfo::Status::Disconnected,
+                              CLICall::DefaultTimeoutMSecs);
+    QVERIFY(m_checker->snapshot()->sequence > base + 2);
+    QCOMPARE(m_checker->snapshot()->info.status(), NordVpnInfo::Status::Disconnected);
+}
+
+void TestStateChecker::test_fingerprint_fast_path()
+{
+    const QString connected = QStringLiteral("Status: Connected\nCountry: Finland\nCity: Helsinki\n"
+                                             "Transfer: 1 MiB received, 2 KiB sent\nUptime: 5 seconds\n");
+    const QString ticked = QStringLiteral("Status: Connected\nCountry: Finland\nCity: Helsinki\n"
+                                          "Transfer: 3 MiB received, 4 KiB sent\nUptime: 6 seconds\n");
+    QCOMPARE(NordVpnInfo::structuralFingerprint(connected), NordVpnInfo::structuralFingerprint(ticked));
+    QVERIFY(NordVpnInfo::structuralFingerprint(connected)
+            != NordVpnInfo::structuralFingerprint(QStringLiteral("Status: Connected\nCountry: Finland\n")));
+
+    m_checker->setTrafficInterval(0);
+    m_checker->setTelemetryInterval(0);
+
+    const StateChecker::FingerprintStats before = m_checker->fingerprintStats();
+    QSignalSpy spyState(m_checker.get(), &StateChecker::stateChanged);
+    QSignalSpy spyTelemetry(m_checker.get(), &StateChecker::telemetryChanged);
+
+    m_checker->onQueryFinish({}, connected, true, {});
+    QTRY_COMPARE(spyState.count(), 1);
+    QCOMPARE(m_checker->fingerprintStats().misses, before.misses + 1);
+
+    m_checker->onQueryFinish({}, ticked, true, {});
+    QCOMPARE(m_checker->fingerprintStats().hits, before.hits + 1);
+    QCOMPARE(spyState.count(), 1);
+    QCOMPARE(spyTelemetry.count(), 1);
+    QCOMPARE(m_checker->state(), NordVpnInfo::fromString(ticked));
+    QCOMPARE(m_checker->snapshot()->info, NordVpnInfo::fromString(ticked));
+
+    // identical output is a hit without any notification
+    m_checker->onQueryFinish({}, ticked, true, {});
+    QCOMPARE(m_checker->fingerprintStats().hits, before.hits + 2);
+    QCOMPARE(spyTelemetry.count(), 1);
+
+    // a structural change goes through the full parse
+    m_checker->onQueryFinish({}, QStringLiteral("Status: Disconnected\n"), true, {});
+    QCOMPARE(m_checker->fingerprintStats().misses, before.misses + 2);
+    QTRY_COMPARE(m_checker->state().status(), NordVpnInfo::Status::Disconnected);
+    QCOMPARE(spyState.count(), 2);
+
+    // a manual status change invalidates the fingerprint
+    m_checker->setStatus(NordVpnInfo::Status::Unknown);
+    m_checker->onQueryFinish({}, QStringLiteral("Status: Disconnected\n"), true, {});
+    QCOMPARE(m_checker->fingerprintStats().misses, before.misses + 3);
+    QTRY_COMPARE(m_checker->state().status(), NordVpnInfo::Status::Disconnected);
+
+    m_checker->setTelemetryInterval(StateChecker::DefaultTelemetryIntervalMs);
+    m_checker->setTrafficInterval(TrafficMonitor::DefaultIntervalMs);
+}
+
 QTEST_MAIN(TestStateChecker)
 #include "teststatechecker.moc"
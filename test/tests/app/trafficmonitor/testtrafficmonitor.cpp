@@ -0,0 +1,229 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "app/nordvpninfo.h"
+#include "app/trafficmonitor.h"
+
+#include <QDir>
+#include <QFile>
+#include <QLocale>
+#include <QObject>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+class TestTrafficMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestTrafficMonitor(QObject *parent = {});
+
+private slots:
+    void init();
+
+    void test_no_interface();
+    void test_find_interface();
+    void test_counters_and_rates();
+    void test_counters_reset();
+    void test_interface_recreated();
+    void test_forced_interface();
+    void test_start_stop();
+    void test_info_traffic();
+
+private:
+    std::unique_ptr<QTemporaryDir> m_root;
+
+    void writeCounters(const QString &iface, quint64 rx, quint64 tx);
+    void removeInterface(const QString &iface);
+};
+
+TestTrafficMonitor::TestTrafficMonitor(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void TestTrafficMonitor::init()
+{
+    m_root = std::make_unique<QTemporaryDir>();
+    QVERIFY(m_root->isValid());
+    writeCounters(QStringLiteral("lo"), 100, 100);
+    writeCounters(QStringLiteral("eth0"), 5000, 7000);
+}
+
+void TestTrafficMonitor::writeCounters(const QString &iface, quint64 rx, quint64 tx)
+{
+    const QString &dir = m_root->filePath(iface + QStringLiteral("/statistics"));
+    QVERIFY(QDir().mkpath(dir));
+
+    auto write = [&dir](const QString &name, quint64 value) {
+        QFile file(dir + QLatin1Char('/') + name);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(QByteArray::number(value) + '\n');
+    };
+
+    write(QStringLiteral("rx_bytes"), rx);
+    write(QStringLiteral("tx_bytes"), tx);
+}
+
+void TestTrafficMonitor::removeInterface(const QString &iface)
+{
+    QVERIFY(QDir(m_root->filePath(iface)).removeRecursively());
+}
+
+void TestTrafficMonitor::test_no_interface()
+{
+    TrafficMonitor monitor;
+    monitor.setSysfsRoot(m_root->path());
+
+    QCOMPARE(monitor.findInterface(), QString());
+    QCOMPARE(monitor.poll(), false);
+    QCOMPARE(monitor.sample().valid, false);
+}
+
+void TestTrafficMonitor::test_find_interface()
+{
+    TrafficMonitor monitor;
+    monitor.setSysfsRoot(m_root->path());
+
+    // tunnels of other VPNs are not ours
+    writeCounters(QStringLiteral("tun0"), 1, 1);
+    writeCounters(QStringLiteral("wg0"), 1, 1);
+    QVERIFY(monitor.findInterface().isEmpty());
+
+    writeCounters(QStringLiteral("nordtun"), 1, 1);
+    QCOMPARE(monitor.findInterface(), QStringLiteral("nordtun"));
+
+    // earlier prefixes win
+    writeCounters(QStringLiteral("nordlynx"), 1, 1);
+    QCOMPARE(monitor.findInterface(), QStringLiteral("nordlynx"));
+}
+
+void TestTrafficMonitor::test_counters_and_rates()
+{
+    TrafficMonitor monitor;
+    monitor.setSysfsRoot(m_root->path());
+    QSignalSpy spy(&monitor, &TrafficMonitor::sampleChanged);
+
+    writeCounters(QStringLiteral("nordlynx"), 1000, 500);
+    QVERIFY(monitor.poll());
+    QCOMPARE(monitor.sample().iface, QStringLiteral("nordlynx"));
+    QCOMPARE(monitor.sample().rxBytes, quint64(1000));
+    QCOMPARE(monitor.sample().txBytes, quint64(500));
+    QCOMPARE(monitor.sample().rxRate, 0.);
+    QCOMPARE(spy.count(), 1);
+
+    QTest::qWait(100);
+    writeCounters(QStringLiteral("nordlynx"), 3000, 600);
+    QVERIFY(monitor.poll());
+    QCOMPARE(monitor.sample().rxBytes, quint64(3000));
+    QVERIFY(monitor.sample().rxRate > 0.);
+    QVERIFY(monitor.sample().rxRate > monitor.sample().txRate);
+    QCOMPARE(spy.count(), 2);
+}
+
+void TestTrafficMonitor::test_counters_reset()
+{
+    TrafficMonitor monitor;
+    monitor.setSysfsRoot(m_root->path());
+
+    writeCounters(QStringLiteral("nordlynx"), 1000, 1000);
+    QVERIFY(monitor.poll());
+
+    QTest::qWait(10);
+    writeCounters(QStringLiteral("nordlynx"), 10, 10);
+    QVERIFY(monitor.poll());
+    QCOMPARE(monitor.sample().rxBytes, quint64(10));
+    QCOMPARE(monitor.sample().rxRate, 0.);
+    QCOMPARE(monitor.sample().txRate, 0.);
+}
+
+void TestTrafficMonitor::test_interface_recreated()
+{
+    TrafficMonitor monitor;
+    monitor.setSysfsRoot(m_root->path());
+
+    writeCounters(QStringLiteral("nordtun"), 1000, 1000);
+    QVERIFY(monitor.poll());
+    QCOMPARE(monitor.sample().iface, QStringLiteral("nordtun"));
+
+    removeInterface(QStringLiteral("nordtun"));
+    writeCounters(QStringLiteral("nordlynx"), 20, 20);
+    QVERIFY(monitor.poll());
+    QCOMPARE(monitor.sample().iface, QStringLiteral("nordlynx"));
+    QCOMPARE(monitor.sample().rxRate, 0.);
+
+    removeInterface(QStringLiteral("nordlynx"));
+    QCOMPARE(monitor.poll(), false);
+    QCOMPARE(monitor.sample().valid, false);
+}
+
+void TestTrafficMonitor::test_forced_interface()
+{
+    TrafficMonitor monitor;
+    monitor.setSysfsRoot(m_root->path());
+    monitor.setInterfaceName(QStringLiteral("eth0"));
+
+    writeCounters(QStringLiteral("nordlynx"), 1, 1);
+    QVERIFY(monitor.poll());
+    QCOMPARE(monitor.interfaceName(), QStringLiteral("eth0"));
+    QCOMPARE(monitor.sample().rxBytes, quint64(5000));
+    QCOMPARE(monitor.sample().txBytes, quint64(7000));
+}
+
+void TestTrafficMonitor::test_start_stop()
+{
+    TrafficMonitor monitor;
+    monitor.setSysfsRoot(m_root->path());
+    monitor.setInterval(20);
+    QSignalSpy spy(&monitor, &TrafficMonitor::sampleChanged);
+
+    writeCounters(QStringLiteral("nordlynx"), 1, 1);
+    monitor.start();
+    QVERIFY(monitor.isActive());
+    QCOMPARE(spy.count(), 1);
+
+    writeCounters(QStringLiteral("nordlynx"), 2, 2);
+    QTRY_COMPARE(monitor.sample().rxBytes, quint64(2));
+
+    monitor.stop();
+    QVERIFY(!monitor.isActive());
+    QCOMPARE(monitor.sample().valid, false);
+    QCOMPARE(spy.last().at(0).value<TrafficMonitor::Sample>().valid, false);
+}
+
+void TestTrafficMonitor::test_info_traffic()
+{
+    NordVpnInfo info = NordVpnInfo::fromString(
+            QStringLiteral("Status: Connected\nTransfer: 0.97 MiB received, 452.22 KiB sent\n"));
+    QCOMPARE(info.hasTrafficCounters(), false);
+    QCOMPARE(info.trafficSource(), NordVpnInfo::TrafficSource::Cli);
+
+    const NordVpnInfo plain = info;
+    info.setTrafficCounters(2048, 1024, 512., 0.);
+    QVERIFY(info.hasTrafficCounters());
+    QVERIFY(info != plain);
+    QVERIFY(info.traffic().contains(QLocale().formattedDataSize(2048)));
+    QVERIFY(info.toString().contains(info.traffic()));
+
+    info.clearTrafficCounters();
+    QCOMPARE(info.trafficSource(), NordVpnInfo::TrafficSource::None);
+    QCOMPARE(info.rxBytes(), quint64(0));
+    QVERIFY(info.sameStructure(plain));
+}
+
+QTEST_MAIN(TestTrafficMonitor)
+#include "testtrafficmonitor.moc"
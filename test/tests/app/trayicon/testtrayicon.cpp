@@ -0,0 +1,141 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "app/connectionhistory.h"
+#include "app/trayicon.h"
+#include "settings/appsettings.h"
+
+#include <QObject>
+#include <QTest>
+#include <QTextDocumentFragment>
+
+class TestTrayIcon : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestTrayIcon(QObject *parent = {});
+
+private slots:
+    void initTestCase();
+
+    void test_message_html();
+    void test_render_cache();
+    void test_tooltip_sparkline();
+
+private:
+    static NordVpnInfo connected(const QString &traffic);
+};
+
+TestTrayIcon::TestTrayIcon(QObject *parent)
+    : QObject(parent)
+{
+}
+
+void TestTrayIcon::initTestCase()
+{
+    AppSettings::init();
+}
+
+/*static*/ NordVpnInfo TestTrayIcon::connected(const QString &traffic)
+{
+    return NordVpnInfo::fromString(QStringLiteral("Status: Connected\nCurrent server: de1.nordvpn.com\n"
+                                                  "Country: Germany\nCity: Berlin\nTransfer: %1\n")
+                                           .arg(traffic));
+}
+
+void TestTrayIcon::test_render_cache()
+{
+    TrayIcon tray;
+
+    const NordVpnInfo &state = connected(QStringLiteral("1 KiB received, 2 KiB sent"));
+    tray.setTelemetry(state);
+    QVERIFY(tray.m_rendered.valid);
+    QVERIFY(!tray.m_rendered.toolTipDirty);
+    QVERIFY(tray.m_rendered.text.contains(QStringLiteral("Berlin")));
+    QVERIFY(!tray.m_rendered.text.contains(QLatin1Char('<')));
+    QCOMPARE(tray.toolTip(), tray.m_rendered.text);
+
+    // an identical state reuses the rendered strings
+    const QChar *html = tray.m_rendered.structureHtml.constData();
+    const QChar *text = tray.m_rendered.text.constData();
+    tray.setState(state);
+    tray.setTelemetry(state);
+    QCOMPARE(tray.m_rendered.structureHtml.constData(), html);
+    QCOMPARE(tray.m_rendered.text.constData(), text);
+
+    // new telemetry keeps the formatted structure
+    const QString previous = tray.m_rendered.text;
+    const QChar *structureText = tray.m_rendered.structureText.constData();
+    const NordVpnInfo &moreTraffic = connected(QStringLiteral("3 KiB received, 4 KiB sent"));
+    tray.setTelemetry(moreTraffic);
+    QVERIFY(tray.m_rendered.text != previous);
+    QCOMPARE(tray.m_rendered.structureHtml.constData(), html);
+    QCOMPARE(tray.m_rendered.structureText.constData(), structureText);
+    QVERIFY(tray.m_rendered.text.endsWith(moreTraffic.traffic()));
+    QCOMPARE(tray.toolTip(), tray.m_rendered.text);
+    QVERIFY(tray.m_rendered.state.sameTelemetry(moreTraffic));
+
+    const NordVpnInfo &disconnected = NordVpnInfo::fromString(QStringLiteral("Status: Disconnected\n"));
+    tray.setState(disconnected);
+    QVERIFY(!tray.toolTip().contains(QStringLiteral("Berlin")));
+}
+
+void TestTrayIcon::test_message_html()
+{
+    TrayIcon tray;
+
+    // the same layout as NordVpnInfo::toString(), in both the rich and the plain form
+    auto checkLayout = [&tray](const NordVpnInfo &state) {
+        tray.setTelemetry(state);
+        QCOMPARE(tray.messageHtml(), state.toString());
+        QCOMPARE(tray.m_rendered.text, QTextDocumentFragment::fromHtml(state.toString()).toPlainText());
+    };
+
+    const NordVpnInfo &state = connected(QStringLiteral("1 KiB received, 2 KiB sent"));
+    checkLayout(state);
+    QVERIFY(state.toString().endsWith(QStringLiteral("<br>%1").arg(state.traffic())));
+
+    checkLayout(NordVpnInfo::fromString(QStringLiteral("Status: Connected\nCurrent server: de1.nordvpn.com\n"
+                                                        "Uptime: 1 hour 2 minutes\n")));
+    checkLayout(NordVpnInfo::fromString(QStringLiteral("Status: Disconnected\n")));
+}
+
+void TestTrayIcon::test_tooltip_sparkline()
+{
+    TrayIcon tray;
+    ConnectionHistory history(8, 2, 2);
+    tray.setHistory(&history);
+
+    history.append(connected(QStringLiteral("0 B received, 0 B sent")), 0);
+    history.append(connected(QStringLiteral("100 B received, 0 B sent")), 1000);
+    history.append(connected(QStringLiteral("300 B received, 0 B sent")), 2000);
+
+    const NordVpnInfo &state = connected(QStringLiteral("300 B received, 0 B sent"));
+    tray.setState(state);
+    const QString &sparkline = history.sparkline(TrayIcon::SparklineWidth);
+    QVERIFY(!sparkline.isEmpty());
+    QCOMPARE(tray.toolTip(), QStringLiteral("%1\n%2").arg(tray.m_rendered.text, sparkline));
+    QCOMPARE(tray.m_rendered.historyRevision, history.revision());
+
+    history.append(connected(QStringLiteral("1300 B received, 0 B sent")), 3000);
+    tray.setTelemetry(state);
+    QVERIFY(tray.toolTip().endsWith(history.sparkline(TrayIcon::SparklineWidth)));
+    QCOMPARE(tray.m_rendered.historyRevision, history.revision());
+}
+
+QTEST_MAIN(TestTrayIcon)
+#include "testtrayicon.moc"
@@ -18,6 +18,7 @@
 #include "actions/testaction.h"
 #include "cli/clicall.h"
 
+#include <QElapsedTimer>
 #include <QSignalSpy>
 #include <QTest>
 
@@ -26,6 +27,11 @@ class TestCLICall : public QObject
     Q_OBJECT
 private slots:
     void test_call();
+    void test_start();
+    void test_timeout();
+    void test_cancel();
+    void test_notFound();
+    void test_sharedResultTimings();
 };
 
 void TestCLICall::test_call()
@@ -56,5 +62,113 @@ void TestCLICall::test_call()
     QCOMPARE(call->errors(), QString());
 }
 
+struct CallOutcome {
+    int readyCount = 0;
+    bool success = false;
+    QString result;
+    QString errors;
+};
+
+static void watchCall(CLICall *call, CallOutcome &outcome)
+{
+    QObject::connect(call, &CLICall::ready, call, [call, &outcome](const QString &result) {
+        ++outcome.readyCount;
+        outcome.success = call->success();
+        outcome.result = result;
+        outcome.errors = call->errors();
+    });
+}
+
+void TestCLICall::test_start()
+{
+    const Action::Ptr action(new TestAction());
+    action->setApp("/usr/bin/ls");
+    action->setArgs({ "-la" });
+
+    CLICall *call = action->createRequest();
+    CallOutcome outcome;
+    watchCall(call, outcome);
+
+    QVERIFY(call->start());
+    QVERIFY(call->isRunning());
+    QTRY_COMPARE_WITH_TIMEOUT(outcome.readyCount, 1, CLICall::DefaultTimeoutMSecs);
+
+    QVERIFY(outcome.success);
+    QVERIFY(outcome.result.contains("Test_CLICall"));
+    QCOMPARE(outcome.errors, QString());
+}
+
+void TestCLICall::test_timeout()
+{
+    const Action::Ptr action(new TestAction());
+    action->setApp("/usr/bin/sleep");
+    action->setArgs({ "10" });
+    action->setTimeout(100);
+
+    CLICall *call = action->createRequest();
+    CallOutcome outcome;
+    watchCall(call, outcome);
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(call->start());
+    QTRY_COMPARE_WITH_TIMEOUT(outcome.readyCount, 1, CLICall::DefaultTimeoutMSecs);
+    QVERIFY(timer.elapsed() < 5000);
+
+    QTest::qWait(50);
+    QCOMPARE(outcome.readyCount, 1);
+    QVERIFY(!outcome.success);
+    QVERIFY(!outcome.errors.isEmpty());
+}
+
+void TestCLICall::test_cancel()
+{
+    const Action::Ptr action(new TestAction());
+    action->setApp("/usr/bin/sleep");
+    action->setArgs({ "10" });
+
+    CLICall *call = action->createRequest();
+    CallOutcome outcome;
+    watchCall(call, outcome);
+
+    QVERIFY(call->start());
+    QVERIFY(call->isRunning());
+    call->cancel();
+
+    QCOMPARE(outcome.readyCount, 1);
+    QVERIFY(!outcome.success);
+
+    QTest::qWait(50);
+    QCOMPARE(outcome.readyCount, 1);
+}
+
+void TestCLICall::test_notFound()
+{
+    CLICall call("/nonexistent/yangl/app", {}, CLICall::DefaultTimeoutMSecs);
+    QSignalSpy spy(&call, &CLICall::ready);
+
+    QVERIFY(!call.start());
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(!call.errors().isEmpty());
+}
+
+void TestCLICall::test_sharedResultTimings()
+{
+    CLICall call("/usr/bin/echo", { "countries" }, CLICall::DefaultTimeoutMSecs);
+    call.run();
+    QVERIFY(call.timings().bytesRead > 0);
+
+    // completed from the cache or by another call: nothing read by this one
+    for (auto origin : { CLICall::Origin::Cache, CLICall::Origin::Coalesced }) {
+        call.announceStart();
+        call.complete(QStringLiteral("countries"), {}, 0, QProcess::NormalExit, origin);
+        QCOMPARE(call.origin(), origin);
+        QCOMPARE(call.timings().bytesRead, qint64(0));
+    }
+
+    call.run();
+    QCOMPARE(call.timings().bytesRead, qint64(QByteArray("countries\n").size()));
+}
+
 QTEST_MAIN(TestCLICall)
 #include "testclicall.moc"
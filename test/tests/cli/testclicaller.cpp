@@ -19,7 +19,9 @@
 #include "cli/clicaller.h"
 
 #include <QElapsedTimer>
+#include <QFileInfo>
 #include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QTest>
 #include <memory>
 
@@ -28,9 +30,31 @@ class TestCLICaller : public QObject
     Q_OBJECT
 
 private slots:
+    void initTestCase();
+    void cleanupTestCase();
     void test_performAction();
+    void test_coalescing();
+    void test_mutatingNotCoalesced();
+
+private:
+    QString m_app;
+    QTemporaryDir m_dir;
 };
 
+void TestCLICaller::initTestCase()
+{
+    m_app = QFileInfo(QString(qApp->applicationFilePath()).replace(qAppName(), "../../../../tests/test_fake_status"))
+                    .absoluteFilePath();
+    QVERIFY(QFileInfo::exists(m_app));
+
+    qputenv("YANGL_FAKE_NVPN", QString("--state %1 --latency 200").arg(m_dir.filePath("nvpn.state")).toUtf8());
+}
+
+void TestCLICaller::cleanupTestCase()
+{
+    qunsetenv("YANGL_FAKE_NVPN");
+}
+
 void TestCLICaller::test_performAction()
 {
     Action::Ptr action(new TestAction(Action::Flow::Custom, Action::NordVPN::Unknown));
@@ -61,5 +85,51 @@ void TestCLICaller::test_performAction()
     QVERIFY(arguments.at(2).toBool() == true);
 }
 
+void TestCLICaller::test_coalescing()
+{
+    Action::Ptr action(new TestAction(Action::Flow::Custom, Action::NordVPN::Unknown));
+    action->setApp(m_app);
+    action->setArgs({ "status" });
+
+    QSignalSpy spy(action.get(), &Action::performed);
+
+    std::unique_ptr<CLICaller> caller(new CLICaller);
+    static constexpr int requests = 5;
+    for (int i = 0; i < requests; ++i)
+        QVERIFY(caller->performAction(action.get(), CLIExecutor::Lane::Polling));
+
+    QCOMPARE(caller->executor()->stats(CLIExecutor::Lane::Polling).started, 1);
+    QCOMPARE(caller->stats().requested, requests);
+    QCOMPARE(caller->stats().coalesced, requests - 1);
+
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), requests, CLICall::DefaultTimeoutMSecs);
+    for (const auto &arguments : spy)
+        QVERIFY(arguments.at(2).toBool());
+
+    QVERIFY(caller->performAction(action.get(), CLIExecutor::Lane::Polling));
+    QCOMPARE(caller->executor()->stats(CLIExecutor::Lane::Polling).started, 2);
+    QCOMPARE(caller->stats().coalesced, requests - 1);
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), requests + 1, CLICall::DefaultTimeoutMSecs);
+}
+
+void TestCLICaller::test_mutatingNotCoalesced()
+{
+    Action::Ptr action(new TestAction(Action::Flow::Custom, Action::NordVPN::Unknown));
+    action->setApp("/usr/bin/sleep");
+    action->setArgs({ "0.2" });
+
+    QSignalSpy spy(action.get(), &Action::performed);
+
+    std::unique_ptr<CLICaller> caller(new CLICaller);
+    static constexpr int requests = 3;
+    for (int i = 0; i < requests; ++i)
+        QVERIFY(caller->performAction(action.get(), CLIExecutor::Lane::Interactive));
+
+    QCOMPARE(caller->executor()->stats(CLIExecutor::Lane::Interactive).started, requests);
+    QCOMPARE(caller->stats().coalesced, 0);
+
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), requests, CLICall::DefaultTimeoutMSecs);
+}
+
 QTEST_MAIN(TestCLICaller)
 #include "testclicaller.moc"
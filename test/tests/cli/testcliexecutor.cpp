@@ -0,0 +1,129 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "cli/clicall.h"
+#include "cli/cliexecutor.h"
+
+#include <QSignalSpy>
+#include <QTest>
+
+class TestCLIExecutor : public QObject
+{
+    Q_OBJECT
+private slots:
+    void test_limits();
+    void test_interactiveNotBlocked();
+    void test_stats();
+    void test_failedStartReleasesSlot();
+};
+
+void TestCLIExecutor::test_limits()
+{
+    CLIExecutor executor;
+    QCOMPARE(executor.limit(CLIExecutor::Lane::Interactive),
+             CLIExecutor::defaultLimit(CLIExecutor::Lane::Interactive));
+    QCOMPARE(executor.limit(CLIExecutor::Lane::Polling), CLIExecutor::defaultLimit(CLIExecutor::Lane::Polling));
+    QCOMPARE(executor.limit(CLIExecutor::Lane::Bulk), CLIExecutor::defaultLimit(CLIExecutor::Lane::Bulk));
+
+    executor.setLimit(CLIExecutor::Lane::Bulk, 3);
+    QCOMPARE(executor.limit(CLIExecutor::Lane::Bulk), 3);
+
+    executor.setLimit(CLIExecutor::Lane::Bulk, 0);
+    QCOMPARE(executor.limit(CLIExecutor::Lane::Bulk), 1);
+}
+
+void TestCLIExecutor::test_interactiveNotBlocked()
+{
+    CLIExecutor executor;
+    executor.setLimit(CLIExecutor::Lane::Bulk, 1);
+
+    QList<CLICall *> bulk;
+    for (int i = 0; i < 3; ++i) {
+        auto call = new CLICall("/usr/bin/sleep", { "2" }, CLICall::DefaultTimeoutMSecs, this);
+        bulk.append(call);
+        executor.enqueue(call, CLIExecutor::Lane::Bulk);
+    }
+
+    QCOMPARE(executor.stats(CLIExecutor::Lane::Bulk).inFlight, 1);
+    QCOMPARE(executor.stats(CLIExecutor::Lane::Bulk).queued, 2);
+
+    auto interactive = new CLICall("/usr/bin/ls", {}, CLICall::DefaultTimeoutMSecs, this);
+    QSignalSpy spy(interactive, &CLICall::ready);
+    executor.enqueue(interactive, CLIExecutor::Lane::Interactive);
+
+    QCOMPARE(executor.stats(CLIExecutor::Lane::Interactive).inFlight, 1);
+    QVERIFY(spy.wait(1000));
+    QCOMPARE(executor.stats(CLIExecutor::Lane::Interactive).inFlight, 0);
+
+    QVERIFY(bulk.first()->isRunning());
+    QVERIFY(!bulk.last()->isRunning());
+
+    qDeleteAll(bulk);
+    QCOMPARE(executor.stats(CLIExecutor::Lane::Bulk).inFlight, 0);
+    QCOMPARE(executor.stats(CLIExecutor::Lane::Bulk).queued, 0);
+    delete interactive;
+}
+
+void TestCLIExecutor::test_stats()
+{
+    CLIExecutor executor;
+    executor.setLimit(CLIExecutor::Lane::Polling, 1);
+
+    auto first = new CLICall("/usr/bin/sleep", { "0.2" }, CLICall::DefaultTimeoutMSecs, this);
+    auto second = new CLICall("/usr/bin/ls", {}, CLICall::DefaultTimeoutMSecs, this);
+    QSignalSpy spy(second, &CLICall::ready);
+
+    executor.enqueue(first, CLIExecutor::Lane::Polling);
+    executor.enqueue(second, CLIExecutor::Lane::Polling);
+    QCOMPARE(executor.stats(CLIExecutor::Lane::Polling).maxQueued, 1);
+
+    QVERIFY(spy.wait(CLICall::DefaultTimeoutMSecs));
+
+    const CLIExecutor::LaneStats &stats = executor.stats(CLIExecutor::Lane::Polling);
+    QCOMPARE(stats.started, 2);
+    QVERIFY(stats.maxWaitMs >= 100);
+    QVERIFY(stats.totalWaitMs >= stats.maxWaitMs);
+
+    delete first;
+    delete second;
+}
+
+void TestCLIExecutor::test_failedStartReleasesSlot()
+{
+    CLIExecutor executor;
+    executor.setLimit(CLIExecutor::Lane::Interactive, 1);
+
+    auto running = new CLICall("/usr/bin/sleep", { "1" }, CLICall::DefaultTimeoutMSecs, this);
+    QVERIFY(running->start());
+
+    executor.enqueue(running, CLIExecutor::Lane::Interactive);
+    QCOMPARE(executor.stats(CLIExecutor::Lane::Interactive).inFlight, 0);
+    QVERIFY(running->isRunning());
+
+    auto next = new CLICall("/usr/bin/ls", {}, CLICall::DefaultTimeoutMSecs, this);
+    QSignalSpy spy(next, &CLICall::ready);
+    executor.enqueue(next, CLIExecutor::Lane::Interactive);
+    QCOMPARE(executor.stats(CLIExecutor::Lane::Interactive).inFlight, 1);
+    QVERIFY(spy.wait(1000));
+    QCOMPARE(executor.stats(CLIExecutor::Lane::Interactive).inFlight, 0);
+
+    delete running;
+    delete next;
+}
+
+QTEST_MAIN(TestCLIExecutor)
+#include "testcliexecutor.moc"
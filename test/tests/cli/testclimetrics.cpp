@@ -0,0 +1,147 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "actions/testaction.h"
+#include "cli/clicaller.h"
+#include "cli/climetrics.h"
+#include "cli/cliresultcache.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+#include <memory>
+
+class TestCLIMetrics : public QObject
+{
+    Q_OBJECT
+private slots:
+    void test_histogram();
+    void test_recordAction();
+    void test_sharedResults();
+    void test_dump();
+};
+
+void TestCLIMetrics::test_histogram()
+{
+    CLIMetrics::Histogram histogram;
+    QCOMPARE(histogram.count(), quint64(0));
+    QCOMPARE(histogram.percentile(0.5), qint64(0));
+
+    for (qint64 value : { 3, 4, 4, 8, 15, 90, 95, 700, 40000 })
+        histogram.add(value);
+    histogram.add(-1);
+
+    QCOMPARE(histogram.count(), quint64(9));
+    QCOMPARE(histogram.min(), qint64(3));
+    QCOMPARE(histogram.max(), qint64(40000));
+    QCOMPARE(histogram.percentile(0.5), qint64(20));
+    QCOMPARE(histogram.percentile(1.), qint64(40000));
+
+    const auto &buckets = histogram.buckets();
+    QCOMPARE(buckets[2], quint64(3)); // (2, 5]
+    QCOMPARE(buckets.back(), quint64(1));
+}
+
+void TestCLIMetrics::test_recordAction()
+{
+    CLIMetrics::instance()->clear();
+
+    Action::Ptr action(new TestAction(Action::Flow::Custom, Action::NordVPN::Unknown));
+    action->setTitle("ls");
+    action->setApp("/usr/bin/ls");
+    action->setArgs({ "-la" });
+
+    QSignalSpy spy(action.get(), &Action::performed);
+    std::unique_ptr<CLICaller> caller(new CLICaller);
+    for (int i = 0; i < 3; ++i) {
+        caller->performAction(action.get());
+        QTRY_COMPARE_WITH_TIMEOUT(spy.count(), i + 1, CLICall::DefaultTimeoutMSecs);
+    }
+
+    QCOMPARE(CLIMetrics::instance()->ids(), QList<QUuid>({ action->id() }));
+
+    const CLIMetrics::Entry &entry = CLIMetrics::instance()->entry(action->id());
+    QCOMPARE(entry.title, QString("ls"));
+    QCOMPARE(entry.calls, quint64(3));
+    QCOMPARE(entry.failures, quint64(0));
+    QCOMPARE(entry.spawn.count(), quint64(3));
+    QCOMPARE(entry.firstByte.count(), quint64(3));
+    QCOMPARE(entry.total.count(), quint64(3));
+    QVERIFY(entry.total.min() >= entry.spawn.min());
+    QVERIFY(entry.bytesRead > 0);
+}
+
+void TestCLIMetrics::test_sharedResults()
+{
+    CLIMetrics::instance()->clear();
+
+    static const Action::Id metricsId = QUuid::createUuid();
+    QList<Action::Ptr> workers;
+    for (int i = 0; i < 3; ++i) {
+        Action::Ptr action(new TestAction(Action::Flow::Custom, Action::NordVPN::Unknown));
+        action->setTitle("countries");
+        action->setApp("/usr/bin/echo");
+        action->setArgs({ "countries" });
+        action->setMetricsId(metricsId);
+        workers.append(action);
+    }
+
+    std::unique_ptr<CLICaller> caller(new CLICaller);
+    auto cache = new CLIResultCache(QString());
+    cache->setTtl("countries", 3600);
+    caller->setCache(cache);
+
+    QSignalSpy first(workers.at(0).get(), &Action::performed);
+    QSignalSpy second(workers.at(1).get(), &Action::performed);
+    caller->performAction(workers.at(0).get());
+    caller->performAction(workers.at(1).get());
+    QTRY_COMPARE_WITH_TIMEOUT(first.count() + second.count(), 2, CLICall::DefaultTimeoutMSecs);
+
+    QSignalSpy third(workers.at(2).get(), &Action::performed);
+    caller->performAction(workers.at(2).get());
+    QTRY_COMPARE_WITH_TIMEOUT(third.count(), 1, CLICall::DefaultTimeoutMSecs);
+
+    QCOMPARE(CLIMetrics::instance()->ids(), QList<QUuid>({ metricsId }));
+
+    const CLIMetrics::Entry &entry = CLIMetrics::instance()->entry(metricsId);
+    QCOMPARE(entry.calls, quint64(1));
+    QCOMPARE(entry.coalesced, quint64(1));
+    QCOMPARE(entry.cacheHits, quint64(1));
+    QCOMPARE(entry.total.count(), quint64(1));
+}
+
+void TestCLIMetrics::test_dump()
+{
+    QTemporaryDir dir;
+    const QString &path = dir.filePath("metrics.json");
+    QVERIFY(CLIMetrics::instance()->dump(path));
+
+    QFile in(path);
+    QVERIFY(in.open(QFile::ReadOnly));
+    const QJsonObject &jRoot = QJsonDocument::fromJson(in.readAll()).object();
+    const QJsonArray &jActions = jRoot.value("actions").toArray();
+    QCOMPARE(jActions.size(), CLIMetrics::instance()->ids().size());
+    if (!jActions.isEmpty()) {
+        const QJsonObject &jTotal = jActions.first().toObject().value("totalMs").toObject();
+        QCOMPARE(jTotal.value("buckets").toArray().size(), qsizetype(CLIMetrics::Histogram::BucketsCount));
+    }
+}
+
+QTEST_MAIN(TestCLIMetrics)
+#include "testclimetrics.moc"
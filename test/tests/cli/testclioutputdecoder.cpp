@@ -0,0 +1,138 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "cli/clicall.h"
+#include "cli/clioutputdecoder.h"
+
+#include <QSignalSpy>
+#include <QTest>
+
+class TestCLIOutputDecoder : public QObject
+{
+    Q_OBJECT
+private slots:
+    void test_spinner();
+    void test_lineContent();
+    void test_carriageReturn();
+    void test_ansi();
+    void test_chunks();
+    void test_result();
+    void test_longSpinner();
+    void test_callLines();
+};
+
+void TestCLIOutputDecoder::test_spinner()
+{
+    CLIOutputDecoder decoder;
+    const QList<QString> &lines = decoder.feed("\r-\r  \r\\\r  \r|\r  \r/\rStatus: Connected\nCountry: Finland\n");
+    QCOMPARE(lines, QList<QString>({ "Status: Connected", "Country: Finland" }));
+    QCOMPARE(decoder.result(), QString("Status: Connected\nCountry: Finland"));
+}
+
+void TestCLIOutputDecoder::test_lineContent()
+{
+    CLIOutputDecoder decoder;
+    const QList<QString> &lines =
+            decoder.feed("\r-\r  \rUsage:\n  - connect\n    /path/to\n-v, --version\n| table |\n\\n\n \n");
+    QCOMPARE(lines,
+             QList<QString>({ "Usage:", "  - connect", "    /path/to", "-v, --version", "| table |", "\\n", " " }));
+}
+
+void TestCLIOutputDecoder::test_carriageReturn()
+{
+    CLIOutputDecoder decoder;
+    QCOMPARE(decoder.feed("Connecting...\rConnected\n"), QList<QString>({ "Connected" }));
+    QCOMPARE(decoder.feed("Windows line\r\n"), QList<QString>({ "Windows line" }));
+
+    QVERIFY(decoder.feed("- Germany\r").isEmpty());
+    QCOMPARE(decoder.result(), QString("Connected\nWindows line"));
+    QCOMPARE(decoder.feed("\n"), QList<QString>({ "- Germany" }));
+
+    QVERIFY(decoder.feed("-\r").isEmpty());
+    QVERIFY(decoder.finish().isEmpty());
+    QCOMPARE(decoder.result(), QString("Connected\nWindows line\n- Germany"));
+}
+
+void TestCLIOutputDecoder::test_ansi()
+{
+    CLIOutputDecoder decoder;
+    const QList<QString> &lines = decoder.feed("\x1b[1;32mConnected\x1b[0m to \x1b[4mFinland #88\x1b[0m\n");
+    QCOMPARE(lines, QList<QString>({ "Connected to Finland #88" }));
+}
+
+void TestCLIOutputDecoder::test_chunks()
+{
+    CLIOutputDecoder decoder;
+    QVERIFY(decoder.feed("\r-\rGer").isEmpty());
+    QVERIFY(decoder.feed("many\x1b[").isEmpty());
+    QCOMPARE(decoder.feed("0mFr"), QList<QString>());
+    QCOMPARE(decoder.feed("ance\nIt"), QList<QString>({ "GermanyFrance" }));
+    QCOMPARE(decoder.finish(), QList<QString>({ "It" }));
+    QCOMPARE(decoder.result(), QString("GermanyFrance\nIt"));
+
+    QString utf8Line;
+    const QByteArray city = QString("Zürich\n").toUtf8();
+    for (const char c : city) {
+        const QList<QString> &lines = decoder.feed(QByteArrayView(&c, 1));
+        if (!lines.isEmpty())
+            utf8Line = lines.first();
+    }
+    QCOMPARE(utf8Line, QString("Zürich"));
+}
+
+void TestCLIOutputDecoder::test_result()
+{
+    CLIOutputDecoder decoder;
+    decoder.feed("Albania\n\nArgentina\n");
+    QCOMPARE(decoder.result(), QString("Albania\n\nArgentina"));
+    QCOMPARE(decoder.bytesFed(), qsizetype(19));
+
+    decoder.reset();
+    QCOMPARE(decoder.result(), QString());
+    QCOMPARE(decoder.bytesFed(), qsizetype(0));
+}
+
+void TestCLIOutputDecoder::test_longSpinner()
+{
+    QByteArray data;
+    for (int i = 0; i < 100000; ++i)
+        data.append("\r-\r\\\r|\r/");
+    data.append("\rDone\n");
+
+    CLIOutputDecoder decoder;
+    QBENCHMARK {
+        decoder.reset();
+        QCOMPARE(decoder.feed(data), QList<QString>({ "Done" }));
+    }
+}
+
+void TestCLIOutputDecoder::test_callLines()
+{
+    CLICall call("/usr/bin/printf", { "one\\ntwo\\nthree" }, CLICall::DefaultTimeoutMSecs);
+    QSignalSpy lines(&call, &CLICall::lineReady);
+    QSignalSpy ready(&call, &CLICall::ready);
+
+    QVERIFY(call.start());
+    QVERIFY(ready.wait(CLICall::DefaultTimeoutMSecs));
+
+    QCOMPARE(lines.count(), 3);
+    QCOMPARE(lines.at(2).at(0).toString(), QString("three"));
+    QCOMPARE(call.result(), QString("one\ntwo\nthree"));
+}
+
+QTEST_MAIN(TestCLIOutputDecoder)
+#include "testclioutputdecoder.moc"
@@ -0,0 +1,150 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "actions/testaction.h"
+#include "cli/clicaller.h"
+#include "cli/cliresultcache.h"
+
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+#include <memory>
+
+class TestCLIResultCache : public QObject
+{
+    Q_OBJECT
+private slots:
+    void test_ttl();
+    void test_persistence();
+    void test_invalidate();
+    void test_callerHit();
+
+private:
+    QTemporaryDir m_dir;
+
+    static void completedCall(CLICall *call, const QString &result, int exitCode = 0);
+};
+
+/*static*/ void TestCLIResultCache::completedCall(CLICall *call, const QString &result, int exitCode)
+{
+    call->complete(result, {}, exitCode);
+}
+
+void TestCLIResultCache::test_ttl()
+{
+    CLIResultCache cache(m_dir.filePath("ttl.json"));
+    cache.setTtl("groups", 1);
+
+    CLICall groups("/usr/bin/nordvpn", { "groups" }, CLICall::DefaultTimeoutMSecs);
+    CLICall status("/usr/bin/nordvpn", { "status" }, CLICall::DefaultTimeoutMSecs);
+    CLICall failed("/usr/bin/nordvpn", { "groups" }, CLICall::DefaultTimeoutMSecs);
+
+    QVERIFY(cache.isCacheable(&groups));
+    QVERIFY(!cache.isCacheable(&status));
+
+    completedCall(&status, "Status: Connected");
+    cache.store(&status);
+    QCOMPARE(cache.size(), 0);
+
+    completedCall(&failed, {}, 1);
+    cache.store(&failed);
+    QCOMPARE(cache.size(), 0);
+
+    completedCall(&groups, "Africa_The_Middle_East_And_India\nP2P");
+    cache.store(&groups);
+    QCOMPARE(cache.size(), 1);
+
+    CLIResultCache::Entry entry;
+    QVERIFY(cache.lookup(&groups, &entry));
+    QCOMPARE(entry.result, groups.result());
+    QCOMPARE(cache.stats().hits, 1);
+
+    QTest::qWait(1100);
+    QVERIFY(!cache.lookup(&groups, &entry));
+    QCOMPARE(cache.stats().misses, 1);
+}
+
+void TestCLIResultCache::test_persistence()
+{
+    const QString &path = m_dir.filePath("persist.json");
+    CLICall cities("/usr/bin/nordvpn", { "cities", "Germany" }, CLICall::DefaultTimeoutMSecs);
+    completedCall(&cities, "Berlin\nFrankfurt");
+
+    {
+        CLIResultCache cache(path);
+        cache.setTtl("cities", 3600);
+        cache.store(&cities);
+        cache.save();
+    }
+
+    CLIResultCache restored(path);
+    restored.load();
+    QCOMPARE(restored.size(), 1);
+
+    CLIResultCache::Entry entry;
+    QVERIFY(!restored.lookup(&cities, &entry)); // no TTL configured yet
+
+    restored.setTtl("cities", 3600);
+    QVERIFY(restored.lookup(&cities, &entry));
+    QCOMPARE(entry.result, QString("Berlin\nFrankfurt"));
+}
+
+void TestCLIResultCache::test_invalidate()
+{
+    const QString &path = m_dir.filePath("invalidate.json");
+    CLIResultCache cache(path);
+    cache.setTtl("countries", 3600);
+
+    CLICall countries("/usr/bin/nordvpn", { "countries" }, CLICall::DefaultTimeoutMSecs);
+    completedCall(&countries, "Germany\nFrance");
+    cache.store(&countries);
+    cache.save();
+    QVERIFY(QFile::exists(path));
+
+    cache.invalidate();
+    QCOMPARE(cache.size(), 0);
+    QVERIFY(!QFile::exists(path));
+    QVERIFY(!cache.lookup(&countries, nullptr));
+}
+
+void TestCLIResultCache::test_callerHit()
+{
+    Action::Ptr action(new TestAction(Action::Flow::Custom, Action::NordVPN::Unknown));
+    action->setApp("/usr/bin/echo");
+    action->setArgs({ "countries" });
+
+    std::unique_ptr<CLICaller> caller(new CLICaller);
+    auto cache = new CLIResultCache(m_dir.filePath("caller.json"));
+    cache->setTtl("countries", 3600);
+    caller->setCache(cache);
+
+    QSignalSpy spy(action.get(), &Action::performed);
+
+    QVERIFY(caller->performAction(action.get(), CLIExecutor::Lane::Bulk));
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 1, CLICall::DefaultTimeoutMSecs);
+    QCOMPARE(cache->size(), 1);
+
+    QVERIFY(caller->performAction(action.get(), CLIExecutor::Lane::Bulk));
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 2, CLICall::DefaultTimeoutMSecs);
+
+    QCOMPARE(caller->executor()->stats(CLIExecutor::Lane::Bulk).started, 1);
+    QCOMPARE(cache->stats().hits, 1);
+    QCOMPARE(spy.at(1).at(1).toString(), spy.at(0).at(1).toString());
+}
+
+QTEST_MAIN(TestCLIResultCache)
+#include "testcliresultcache.moc"
@@ -0,0 +1,201 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "actions/testaction.h"
+#include "app/nordvpninfo.h"
+#include "cli/clicaller.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+#include <memory>
+
+class TestFakeNordVpn : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanup();
+
+    void test_connectionStateMachine();
+    void test_catalog();
+    void test_failure();
+    void test_hang();
+    void test_benchmarkStatusPolling();
+    void test_benchmarkCatalog();
+
+private:
+    QString m_app;
+    QTemporaryDir m_dir;
+
+    void configure(const QString &options);
+    Action::Ptr createAction(const QStringList &args, int timeout = CLICall::DefaultTimeoutMSecs) const;
+    static QString perform(CLICaller *caller, Action *action, bool *ok = nullptr,
+                           CLIExecutor::Lane lane = CLIExecutor::Lane::Interactive);
+};
+
+void TestFakeNordVpn::initTestCase()
+{
+    m_app = QFileInfo(QString(qApp->applicationFilePath()).replace(qAppName(), "../../../../tests/test_fake_status"))
+                    .absoluteFilePath();
+    QVERIFY(QFileInfo::exists(m_app));
+}
+
+void TestFakeNordVpn::cleanup()
+{
+    qunsetenv("YANGL_FAKE_NVPN");
+}
+
+void TestFakeNordVpn::configure(const QString &options)
+{
+    qputenv("YANGL_FAKE_NVPN",
+            QString("--state %1 %2").arg(m_dir.filePath("nvpn.state"), options).toUtf8());
+}
+
+Action::Ptr TestFakeNordVpn::createAction(const QStringList &args, int timeout) const
+{
+    Action::Ptr action(new TestAction(Action::Flow::Custom, Action::NordVPN::Unknown));
+    action->setApp(m_app);
+    action->setArgs(args);
+    action->setTimeout(timeout);
+    return action;
+}
+
+/*static*/ QString TestFakeNordVpn::perform(CLICaller *caller, Action *action, bool *ok, CLIExecutor::Lane lane)
+{
+    QSignalSpy spy(action, &Action::performed);
+    caller->performAction(action, lane);
+    if (!spy.wait(CLICall::DefaultTimeoutMSecs))
+        return {};
+
+    if (ok)
+        *ok = spy.first().at(2).toBool();
+    return spy.first().at(1).toString();
+}
+
+void TestFakeNordVpn::test_connectionStateMachine()
+{
+    configure("--connect-time 1500 --spinner 4 --latency 20");
+
+    std::unique_ptr<CLICaller> caller(new CLICaller);
+    const Action::Ptr &status = createAction({ "status" });
+
+    perform(caller.get(), createAction({ "disconnect" }).get());
+    QCOMPARE(NordVpnInfo::fromString(perform(caller.get(), status.get())).status(),
+             NordVpnInfo::Status::Disconnected);
+
+    const Action::Ptr &connect = createAction({ "connect", "Germany", "Berlin" });
+    QSignalSpy connected(connect.get(), &Action::performed);
+    caller->performAction(connect.get());
+
+    QTRY_COMPARE_WITH_TIMEOUT(NordVpnInfo::fromString(perform(caller.get(), status.get())).status(),
+                              NordVpnInfo::Status::Connecting, 1000);
+    QVERIFY(connected.wait(CLICall::DefaultTimeoutMSecs));
+
+    const NordVpnInfo &info = NordVpnInfo::fromString(perform(caller.get(), status.get()));
+    QCOMPARE(info.status(), NordVpnInfo::Status::Connected);
+    QCOMPARE(info.country(), QString("Germany"));
+    QCOMPARE(info.city(), QString("Berlin"));
+
+    perform(caller.get(), createAction({ "d" }).get());
+    QCOMPARE(NordVpnInfo::fromString(perform(caller.get(), status.get())).status(),
+             NordVpnInfo::Status::Disconnected);
+}
+
+void TestFakeNordVpn::test_catalog()
+{
+    configure("--countries-count 120 --cities-count 5 --spinner 3");
+
+    std::unique_ptr<CLICaller> caller(new CLICaller);
+    const QStringList &countries = perform(caller.get(), createAction({ "countries" }).get()).split('\n');
+    QCOMPARE(countries.size(), 120);
+    QCOMPARE(countries.first(), QString("Finland"));
+
+    const QStringList &cities = perform(caller.get(), createAction({ "cities", countries.last() }).get()).split('\n');
+    QCOMPARE(cities.size(), 5);
+
+    QVERIFY(!perform(caller.get(), createAction({ "groups" }).get()).isEmpty());
+}
+
+void TestFakeNordVpn::test_failure()
+{
+    configure("--fail countries --stderr-noise");
+
+    std::unique_ptr<CLICaller> caller(new CLICaller);
+
+    bool ok(true);
+    perform(caller.get(), createAction({ "countries" }).get(), &ok);
+    QVERIFY(!ok);
+
+    perform(caller.get(), createAction({ "nonexistent" }).get(), &ok);
+    QVERIFY(!ok);
+}
+
+void TestFakeNordVpn::test_hang()
+{
+    configure("--hang status");
+
+    std::unique_ptr<CLICaller> caller(new CLICaller);
+
+    QElapsedTimer timer;
+    timer.start();
+    bool ok(true);
+    perform(caller.get(), createAction({ "status" }, 300).get(), &ok);
+    QVERIFY(!ok);
+    QVERIFY(timer.elapsed() < CLICall::DefaultTimeoutMSecs);
+}
+
+void TestFakeNordVpn::test_benchmarkStatusPolling()
+{
+    configure("--latency 30 --jitter 20 --spinner 2");
+
+    std::unique_ptr<CLICaller> caller(new CLICaller);
+    const Action::Ptr &status = createAction({ "status" });
+
+    QBENCHMARK {
+        QVERIFY(!perform(caller.get(), status.get(), nullptr, CLIExecutor::Lane::Polling).isEmpty());
+    }
+}
+
+void TestFakeNordVpn::test_benchmarkCatalog()
+{
+    configure("--countries-count 60 --cities-count 4 --latency 20 --city-latency 30");
+
+    std::unique_ptr<CLICaller> caller(new CLICaller);
+    const QStringList &countries = perform(caller.get(), createAction({ "countries" }).get()).split('\n');
+
+    QList<Action::Ptr> queries;
+    for (const auto &country : countries)
+        queries.append(createAction({ "cities", country }));
+
+    QBENCHMARK {
+        qsizetype done(0);
+        QList<QMetaObject::Connection> connections;
+        for (const auto &query : std::as_const(queries)) {
+            connections.append(connect(query.get(), &Action::performed, this, [&done]() { ++done; }));
+            caller->performAction(query.get(), CLIExecutor::Lane::Bulk);
+        }
+        QTRY_COMPARE_WITH_TIMEOUT(done, queries.size(), CLICall::DefaultTimeoutMSecs * 2);
+        for (const auto &connection : std::as_const(connections))
+            disconnect(connection);
+    }
+}
+
+QTEST_MAIN(TestFakeNordVpn)
+#include "testfakenordvpn.moc"
@@ -16,8 +16,12 @@ along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html
 */
 
 #include "geo/coordinatesresolver.h"
+#include "geo/placenames.h"
 
+#include <QFile>
+#include <QFileInfo>
 #include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QTest>
 #include <qtestcase.h>
 
@@ -31,6 +35,16 @@ private slots:
     void cleanupTestCase();
 
     void test_loadDataBuiltin();
+    void test_requestQueuedUntilReady();
+    void test_database_corrupted();
+    void test_database_countryCorrupted();
+    void test_database_residentOnDemand();
+    void test_database_countryIndex();
+    void test_countryIndex_cached();
+    void test_placeNames_normalized_data();
+    void test_placeNames_normalized();
+    void test_location_normalized_data();
+    void test_location_normalized();
 
     void test_location_real();
     void test_location_real_cases();
@@ -47,6 +61,7 @@ private slots:
 void TestCoordinatesResolver::initTestCase()
 {
     m_resolver = new CoordinatesResolver();
+    QTRY_VERIFY(m_resolver->isReady());
 }
 
 void TestCoordinatesResolver::cleanupTestCase()
@@ -56,8 +71,235 @@ void TestCoordinatesResolver::cleanupTestCase()
 
 void TestCoordinatesResolver::test_loadDataBuiltin()
 {
-    m_resolver->ensureDataLoaded();
-    QCOMPARE(m_resolver->m_data.size(), 241);
+    const auto &warmUp = CoordinatesResolver::warmUp();
+    QVERIFY(warmUp.isFinished());
+    QCOMPARE(warmUp.result(), m_resolver->m_database);
+    QVERIFY(m_resolver->m_database->isValid());
+    QCOMPARE(m_resolver->m_database->countryCount(), quint32(241));
+}
+
+void TestCoordinatesResolver::test_requestQueuedUntilReady()
+{
+    CoordinatesResolver resolver;
+    resolver.m_database = nullptr; // as if the warm-up is still running
+    QVERIFY(!resolver.isReady());
+
+    QSignalSpy readySpy(&resolver, &CoordinatesResolver::ready);
+    QSignalSpy resolvedSpy(&resolver, &CoordinatesResolver::coordinatesResolved);
+
+    const auto idFirst = resolver.requestCoordinates("Finland", "Helsinki");
+    const auto idSecond = resolver.requestCoordinates("Finland", "");
+    QCOMPARE(resolver.m_pending.size(), qsizetype(2));
+    QCOMPARE(resolvedSpy.count(), 0);
+
+    resolver.onDatabaseReady(CoordinatesResolver::warmUp().result());
+    QCOMPARE(readySpy.count(), 1);
+    QVERIFY(resolver.m_pending.isEmpty());
+
+    QTRY_COMPARE(resolvedSpy.count(), 2);
+    QList<RequestId> ids;
+    for (const auto &arguments : resolvedSpy) {
+        ids.append(arguments.at(0).value<RequestId>());
+        QCOMPARE(arguments.at(1).value<PlaceInfo>().town, QStringLiteral("Helsinki"));
+    }
+    std::sort(ids.begin(), ids.end());
+    QCOMPARE(ids, QList<RequestId>({ idFirst, idSecond }));
+}
+
+void TestCoordinatesResolver::test_database_corrupted()
+{
+    QFile builtin(QString(CitiesDatabase::BuiltinPath));
+    QVERIFY(builtin.open(QFile::ReadOnly));
+    const QByteArray &image = builtin.readAll();
+
+    CitiesDatabase database;
+    QVERIFY(database.openData(image));
+    QCOMPARE(database.lookup("Finland", "Helsinki").town, QStringLiteral("Helsinki"));
+
+    QByteArray badMagic(image);
+    badMagic[0] = 'X';
+    QVERIFY(!database.openData(badMagic));
+    QVERIFY(!database.isValid());
+    QVERIFY(!database.lookup("Finland", "Helsinki").ok);
+
+    QByteArray badVersion(image);
+    badVersion[4] = char(CitiesDb::FormatVersion + 1);
+    QVERIFY(!database.openData(badVersion));
+
+    QVERIFY(!database.openData(image.left(image.size() / 2)));
+    QVERIFY(!database.openData(QByteArray()));
+}
+
+void TestCoordinatesResolver::test_database_countryCorrupted()
+{
+    QFile builtin(QString(CitiesDatabase::BuiltinPath));
+    QVERIFY(builtin.open(QFile::ReadOnly));
+    QByteArray image = builtin.readAll();
+
+    const auto *header = reinterpret_cast<const CitiesDb::Header *>(image.constData());
+    const auto *countries = reinterpret_cast<const CitiesDb::Country *>(image.constData() + header->countriesOffset);
+    const char *strings = image.constData() + header->stringsOffset;
+    quint32 firstCity = CitiesDb::NoCapital;
+    for (quint32 i = 0; i < header->countryCount; ++i) {
+        if (QByteArrayView(strings + countries[i].key.offset, countries[i].key.size) == "finland") {
+            firstCity = countries[i].firstCity;
+        }
+    }
+    QVERIFY(firstCity != CitiesDb::NoCapital);
+
+    // a city name out of the strings pool spoils its country only, and only once it's looked up
+    auto *cities = reinterpret_cast<CitiesDb::City *>(image.data() + header->citiesOffset);
+    cities[firstCity].name.offset = header->stringsSize;
+
+    CitiesDatabase database;
+    QVERIFY(database.openData(image));
+    QVERIFY(database.lookup("Sweden", "Stockholm").ok);
+    QVERIFY(database.countryIndex("Finland") >= 0);
+    QVERIFY(!database.lookup("Finland", "Helsinki").ok);
+    QVERIFY(!database.lookup("Finland", "").ok);
+}
+
+void TestCoordinatesResolver::test_database_residentOnDemand()
+{
+    QFile smaps(QStringLiteral("/proc/self/smaps"));
+    if (!smaps.exists()) {
+        QSKIP("No /proc/self/smaps to measure the resident pages");
+    }
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString &path = dir.filePath(QStringLiteral("cities.bin"));
+    QVERIFY(QFile::copy(QString(CitiesDatabase::BuiltinPath), path));
+    const QString &mappedPath = QFileInfo(path).canonicalFilePath();
+
+    auto residentKb = [&mappedPath]() {
+        QFile maps(QStringLiteral("/proc/self/smaps"));
+        if (!maps.open(QFile::ReadOnly | QFile::Text)) {
+            return qint64(-1);
+        }
+
+        qint64 total(0);
+        bool inMapping(false);
+        for (const QByteArray &line : maps.readAll().split('\n')) {
+            // a mapping starts with its address range, its attributes are "Name: value" lines
+            const QByteArray &first = line.left(line.indexOf(' '));
+            if (first.contains('-') && !first.endsWith(':')) {
+                inMapping = line.endsWith(mappedPath.toUtf8());
+            } else if (inMapping && line.startsWith("Rss:")) {
+                total += line.mid(4).trimmed().split(' ').constFirst().toLongLong();
+            }
+        }
+        return total;
+    };
+
+    CitiesDatabase database;
+    QVERIFY(database.open(path));
+    const qint64 imageKb = QFileInfo(path).size() / 1024;
+    const qint64 openedKb = residentKb();
+    QVERIFY2(openedKb >= 0 && openedKb < imageKb / 4,
+             qPrintable(QStringLiteral("%1 of %2 KiB").arg(openedKb).arg(imageKb)));
+
+    for (const char *country : { "Finland", "Sweden", "Germany" }) {
+        QVERIFY(database.lookup(country, "").ok);
+    }
+
+    // a few countries page in a fraction of the image, even with the kernel's fault-around
+    const qint64 lookedUpKb = residentKb();
+    QVERIFY2(lookedUpKb < imageKb / 2, qPrintable(QStringLiteral("%1 of %2 KiB").arg(lookedUpKb).arg(imageKb)));
+}
+
+void TestCoordinatesResolver::test_database_countryIndex()
+{
+    const CitiesDatabase *database = CoordinatesResolver::warmUp().result();
+
+    QCOMPARE(database->countryIndex("Oz"), -1);
+    QVERIFY(!database->lookup(-1, "Emerald City").ok);
+    QVERIFY(!database->lookup(int(database->countryCount()), "Helsinki").ok);
+
+    const int finland = database->countryIndex("Finland");
+    QVERIFY(finland >= 0);
+    QCOMPARE(database->countryIndex("finland"), finland);
+    QCOMPARE(database->countryIndex("Finlnd"), finland);
+
+    const auto &helsinki = database->lookup(finland, "HELSINKI");
+    QVERIFY(helsinki.ok);
+    QCOMPARE(helsinki.town, QStringLiteral("Helsinki"));
+
+    const auto &capital = database->lookup(finland, "");
+    QVERIFY(capital.ok);
+    QVERIFY(capital.capital);
+    QCOMPARE(capital.town, QStringLiteral("Helsinki"));
+
+    // one edit away from both Kokkola and Kouvola
+    QVERIFY(!database->lookup(finland, "Koukola").ok);
+    QCOMPARE(database->lookup(finland, "Kokola").town, QStringLiteral("Kokkola"));
+}
+
+void TestCoordinatesResolver::test_countryIndex_cached()
+{
+    CoordinatesResolver resolver;
+    QTRY_VERIFY(resolver.isReady());
+    QVERIFY(resolver.m_countries.isEmpty());
+
+    QVERIFY(resolver.lookupForPlace({ "Finland", "Helsinki" }).ok);
+    QVERIFY(!resolver.lookupForPlace({ "Oz", "Emerald City" }).ok);
+    QCOMPARE(resolver.m_countries.size(), qsizetype(2));
+    QCOMPARE(resolver.m_countries.value("Oz"), -1);
+
+    QVERIFY(resolver.lookupForPlace({ "Finland", "" }).ok);
+    QCOMPARE(resolver.m_countries.size(), qsizetype(2));
+}
+
+void TestCoordinatesResolver::test_placeNames_normalized_data()
+{
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<QString>("key");
+
+    QTest::newRow("case") << "HeLsInKi" << "helsinki";
+    QTest::newRow("underscores") << "United_States" << "united states";
+    QTest::newRow("diacritics") << "Düsseldorf" << "dusseldorf";
+    QTest::newRow("apostrophe") << "Côte d’Ivoire" << "cote divoire";
+    QTest::newRow("abbreviation") << "St. Louis" << "saint louis";
+    QTest::newRow("ampersand") << "Bosnia & Herzegovina" << "bosnia and herzegovina";
+    QTest::newRow("separators") << "  Timor--Leste (East) " << "timor leste east";
+    QTest::newRow("transliteration") << "Straße" << "strasse";
+}
+
+void TestCoordinatesResolver::test_placeNames_normalized()
+{
+    QFETCH(QString, name);
+    QFETCH(QString, key);
+
+    QCOMPARE(PlaceNames::cityKey(name), key);
+    QCOMPARE(PlaceNames::cityKey(key), key);
+}
+
+void TestCoordinatesResolver::test_location_normalized_data()
+{
+    QTest::addColumn<QString>("country");
+    QTest::addColumn<QString>("city");
+    QTest::addColumn<QString>("town");
+
+    QTest::newRow("underscores") << "United_States" << "Saint_Louis" << "St. Louis";
+    QTest::newRow("country alias") << "USA" << "St Louis" << "St. Louis";
+    QTest::newRow("diacritics") << "Germany" << "Düsseldorf" << "Dusseldorf";
+    QTest::newRow("umlaut spelled") << "Germany" << "Moenchengladbach" << "Monchengladbach";
+    QTest::newRow("apostrophe") << "Cote d'Ivoire" << "" << "Abidjan";
+    QTest::newRow("country typo") << "Finlnd" << "Helsinki" << "Helsinki";
+    QTest::newRow("city typo") << "Finland" << "Helsinky" << "Helsinki";
+    QTest::newRow("czechia") << "Czechia" << "" << "Prague";
+    QTest::newRow("default town") << "Finland" << "default" << "Helsinki";
+}
+
+void TestCoordinatesResolver::test_location_normalized()
+{
+    QFETCH(QString, country);
+    QFETCH(QString, city);
+    QFETCH(QString, town);
+
+    const auto &response = m_resolver->lookupForPlace({ country, city });
+    QVERIFY(response.ok);
+    QCOMPARE(response.town, town);
 }
 
 void TestCoordinatesResolver::test_location_real()
@@ -0,0 +1,251 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+This application is free software; you can redistribute it and/or
+modify it under the terms of the GNU Library General Public
+License as published by the Free Software Foundation; either
+version 3 of the License, or (at your option) any later version.
+
+This application is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Library General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+#include "geo/geocodingbackend.h"
+#include "geo/geocodinggovernor.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+
+class StubGeocodingBackend : public GeocodingBackend
+{
+    Q_OBJECT
+public:
+    struct Call {
+        quint64 ticket;
+        QString country;
+        QString city;
+        qint64 startedMs;
+    };
+
+    QList<Call> calls;
+    QElapsedTimer clock;
+
+    StubGeocodingBackend() { clock.start(); }
+
+    void geocode(quint64 ticket, const QString &country, const QString &city) override
+    {
+        calls.append({ ticket, country, city, clock.elapsed() });
+    }
+
+    void respond(int call, const QGeoCoordinate &location, const QString &error = {})
+    {
+        emit finished(calls.at(call).ticket, location, error);
+    }
+};
+
+class TestGeocodingGovernor : public QObject
+{
+    Q_OBJECT
+private:
+    QTemporaryDir m_dir;
+    StubGeocodingBackend *m_backend { nullptr };
+    int m_backendsCreated { 0 };
+
+    QString filePath() const { return m_dir.filePath("geocoding_misses.json"); }
+    GeocodingGovernor *createGovernor(const QString &filePath = {});
+
+private slots:
+    void init();
+    void cleanup();
+
+    void test_backendCreatedOnDemand();
+    void test_identicalRequestsCoalesced();
+    void test_concurrencyAndRateLimited();
+    void test_missCached();
+    void test_missPersisted();
+    void test_missExpired();
+    void test_errorNotCached();
+};
+
+GeocodingGovernor *TestGeocodingGovernor::createGovernor(const QString &filePath)
+{
+    auto *governor = new GeocodingGovernor(
+            filePath,
+            [this]() -> GeocodingBackend * {
+                ++m_backendsCreated;
+                m_backend = new StubGeocodingBackend;
+                return m_backend;
+            },
+            this);
+    governor->setInterval(0);
+    return governor;
+}
+
+void TestGeocodingGovernor::init()
+{
+    QVERIFY(m_dir.isValid());
+    QFile::remove(filePath());
+    m_backend = nullptr;
+    m_backendsCreated = 0;
+}
+
+void TestGeocodingGovernor::cleanup()
+{
+    qDeleteAll(findChildren<GeocodingGovernor *>(Qt::FindDirectChildrenOnly));
+}
+
+void TestGeocodingGovernor::test_backendCreatedOnDemand()
+{
+    auto *governor = createGovernor();
+    QVERIFY(!governor->hasBackend());
+    QCOMPARE(m_backendsCreated, 0);
+
+    governor->geocode(1, { "Oz", "Emerald City" });
+    QTRY_VERIFY(governor->hasBackend());
+    QCOMPARE(m_backendsCreated, 1);
+    QCOMPARE(m_backend->calls.size(), qsizetype(1));
+
+    m_backend->respond(0, {});
+    governor->geocode(2, { "Narnia", "Cair Paravel" });
+    QTRY_COMPARE(m_backend->calls.size(), qsizetype(2));
+    QCOMPARE(m_backendsCreated, 1);
+}
+
+void TestGeocodingGovernor::test_identicalRequestsCoalesced()
+{
+    auto *governor = createGovernor();
+    QSignalSpy spy(governor, &GeocodingGovernor::resolved);
+
+    governor->geocode(1, { "Oz", "Emerald City" });
+    governor->geocode(2, { "oz", "emerald_city" });
+    QTRY_COMPARE(governor->runningCount(), 1);
+    governor->geocode(3, { "OZ", "Emerald  City" });
+
+    QTest::qWait(10);
+    QCOMPARE(m_backend->calls.size(), qsizetype(1));
+
+    m_backend->respond(0, QGeoCoordinate(1., 2.));
+    QTRY_COMPARE(spy.count(), 3);
+
+    QList<RequestId> ids;
+    for (const auto &arguments : spy) {
+        ids.append(arguments.at(0).value<RequestId>());
+        const auto &place = arguments.at(1).value<PlaceInfo>();
+        QVERIFY(place.ok);
+        QCOMPARE(place.location, QGeoCoordinate(1., 2.));
+    }
+    QCOMPARE(ids, QList<RequestId>({ 1, 2, 3 }));
+
+    // each waiter gets its own spelling back
+    QCOMPARE(spy.at(1).at(1).value<PlaceInfo>().town, QStringLiteral("emerald_city"));
+    QCOMPARE(governor->runningCount(), 0);
+}
+
+void TestGeocodingGovernor::test_concurrencyAndRateLimited()
+{
+    static constexpr int IntervalMs = 100;
+
+    auto *governor = createGovernor();
+    governor->setInterval(IntervalMs);
+    governor->setConcurrency(2);
+
+    governor->geocode(1, { "Oz", "Emerald City" });
+    governor->geocode(2, { "Narnia", "Cair Paravel" });
+    governor->geocode(3, { "Atlantis", "" });
+
+    QTRY_COMPARE(m_backend->calls.size(), qsizetype(1));
+    QTRY_COMPARE(m_backend->calls.size(), qsizetype(2));
+    QVERIFY(m_backend->calls.at(1).startedMs - m_backend->calls.at(0).startedMs >= IntervalMs - 1);
+
+    // both slots are busy
+    QTest::qWait(2 * IntervalMs);
+    QCOMPARE(m_backend->calls.size(), qsizetype(2));
+    QCOMPARE(governor->runningCount(), 2);
+    QCOMPARE(governor->pendingCount(), 1);
+
+    m_backend->respond(0, {}, "timeout");
+    QTRY_COMPARE(m_backend->calls.size(), qsizetype(3));
+    QCOMPARE(m_backend->calls.at(2).country, QStringLiteral("Atlantis"));
+}
+
+void TestGeocodingGovernor::test_missCached()
+{
+    auto *governor = createGovernor();
+    QSignalSpy spy(governor, &GeocodingGovernor::resolved);
+
+    governor->geocode(1, { "Oz", "Emerald City" });
+    QTRY_COMPARE(m_backend->calls.size(), qsizetype(1));
+    m_backend->respond(0, {});
+    QTRY_COMPARE(spy.count(), 1);
+    QVERIFY(!spy.at(0).at(1).value<PlaceInfo>().ok);
+    QVERIFY(governor->isKnownMiss({ "oz", "emerald city" }));
+
+    governor->geocode(2, { "Oz", "Emerald City" });
+    QTRY_COMPARE(spy.count(), 2);
+    const auto &place = spy.at(1).at(1).value<PlaceInfo>();
+    QVERIFY(!place.ok);
+    QVERIFY(!place.message.isEmpty());
+    QCOMPARE(m_backend->calls.size(), qsizetype(1));
+}
+
+void TestGeocodingGovernor::test_missPersisted()
+{
+    {
+        auto *governor = createGovernor(filePath());
+        governor->geocode(1, { "Oz", "Emerald City" });
+        QTRY_COMPARE(m_backend->calls.size(), qsizetype(1));
+        m_backend->respond(0, {});
+        QTRY_VERIFY(governor->isKnownMiss({ "Oz", "Emerald City" }));
+        governor->save();
+        delete governor;
+    }
+
+    auto *governor = createGovernor(filePath());
+    QVERIFY(governor->isKnownMiss({ "Oz", "Emerald City" }));
+
+    QSignalSpy spy(governor, &GeocodingGovernor::resolved);
+    governor->geocode(2, { "Oz", "Emerald City" });
+    QTRY_COMPARE(spy.count(), 1);
+    QVERIFY(!governor->hasBackend());
+}
+
+void TestGeocodingGovernor::test_missExpired()
+{
+    auto *governor = createGovernor();
+    governor->setMissTtl(0);
+
+    governor->geocode(1, { "Oz", "Emerald City" });
+    QTRY_COMPARE(m_backend->calls.size(), qsizetype(1));
+    m_backend->respond(0, {});
+    QVERIFY(!governor->isKnownMiss({ "Oz", "Emerald City" }));
+
+    governor->geocode(2, { "Oz", "Emerald City" });
+    QTRY_COMPARE(m_backend->calls.size(), qsizetype(2));
+}
+
+void TestGeocodingGovernor::test_errorNotCached()
+{
+    auto *governor = createGovernor();
+    QSignalSpy spy(governor, &GeocodingGovernor::resolved);
+
+    governor->geocode(1, { "Oz", "Emerald City" });
+    QTRY_COMPARE(m_backend->calls.size(), qsizetype(1));
+    m_backend->respond(0, {}, "Geo reply error: network down");
+    QTRY_COMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(1).value<PlaceInfo>().message, QStringLiteral("Geo reply error: network down"));
+    QVERIFY(!governor->isKnownMiss({ "Oz", "Emerald City" }));
+
+    governor->geocode(2, { "Oz", "Emerald City" });
+    QTRY_COMPARE(m_backend->calls.size(), qsizetype(2));
+}
+
+QTEST_MAIN(TestGeocodingGovernor)
+#include "testgeocodinggovernor.moc"
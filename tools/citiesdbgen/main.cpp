@@ -0,0 +1,240 @@
+/*
+   Copyright (C) 2025 Denis Gofman - <sendevent@gmail.com>
+
+   This application is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Library General Public
+   License as published by the Free Software Foundation; either
+   version 3 of the License, or (at your option) any later version.
+
+   This application is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Library General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program. If not, see <https://www.gnu.org/licenses/lgpl-3.0.html>.
+*/
+
+// Compiles resources/map/cities.csv into the binary image read by CitiesDatabase.
+
+#include "geo/citiesdbformat.h"
+#include "geo/placenames.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QHash>
+#include <QMap>
+#include <QSaveFile>
+#include <QStringList>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+static constexpr qsizetype CSVColumnCount = 5;
+
+struct Row {
+    QString country;
+    QString city;
+    bool capital = false;
+    qint32 latitude = 0;
+    qint32 longitude = 0;
+};
+
+struct CountryRows {
+    QString name;
+    QMap<QByteArray, Row> cities; // QByteArray keys are ordered bytewise, as CitiesDatabase expects
+};
+
+QStringList parseLine(QStringView line)
+{
+    QStringList result;
+    QString field;
+    bool insideQuotes(false);
+
+    for (const QChar c : line) {
+        if (c == QLatin1Char('"')) {
+            insideQuotes = !insideQuotes;
+        } else if (c == QLatin1Char(',') && !insideQuotes) {
+            result.append(field.trimmed());
+            field.clear();
+        } else {
+            field.append(c);
+        }
+    }
+    result.append(field.trimmed());
+    return result;
+}
+
+bool parseCoordinate(const QString &from, double limit, qint32 &to)
+{
+    bool ok(false);
+    const double value = from.toDouble(&ok);
+    if (!ok || std::abs(value) > limit) {
+        return false;
+    }
+
+    to = static_cast<qint32>(std::llround(value * CitiesDb::CoordinateScale));
+    return true;
+}
+
+class Writer
+{
+public:
+    CitiesDb::StringRef intern(const QString &str)
+    {
+        const QByteArray &utf8 = str.toUtf8();
+        auto it = m_offsets.constFind(utf8);
+        if (it == m_offsets.cend()) {
+            it = m_offsets.insert(utf8, static_cast<quint32>(m_pool.size()));
+            m_pool.append(utf8);
+        }
+
+        CitiesDb::StringRef ref;
+        ref.offset = it.value();
+        ref.size = static_cast<quint32>(utf8.size());
+        return ref;
+    }
+
+    const QByteArray &pool() const { return m_pool; }
+
+private:
+    QByteArray m_pool;
+    QHash<QByteArray, quint32> m_offsets;
+};
+
+template<typename T>
+void appendRaw(QByteArray &to, const T &value)
+{
+    to.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void alignTo4(QByteArray &data)
+{
+    while (data.size() % 4) {
+        data.append('\0');
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    const QStringList &args = a.arguments();
+    if (args.size() != 3) {
+        std::cerr << "Usage: citiesdbgen <cities.csv> <cities.bin>" << std::endl;
+        return 1;
+    }
+
+    QFile csv(args.at(1));
+    if (!csv.open(QFile::ReadOnly | QFile::Text)) {
+        std::cerr << "Failed opening " << qPrintable(csv.fileName()) << ": " << qPrintable(csv.errorString())
+                  << std::endl;
+        return 2;
+    }
+
+    QMap<QByteArray, CountryRows> countries;
+    int lineNumber(0);
+    int skipped(0);
+    while (!csv.atEnd()) {
+        ++lineNumber;
+        const QString &line = QString::fromUtf8(csv.readLine()).trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        const QStringList &parts = parseLine(line);
+        Row row;
+        if (parts.size() != CSVColumnCount || parts.at(0).isEmpty() || parts.at(1).isEmpty()
+            || !parseCoordinate(parts.at(3), 90., row.latitude) || !parseCoordinate(parts.at(4), 180., row.longitude)) {
+            std::cerr << "Invalid line " << lineNumber << " ignored: " << qPrintable(line) << std::endl;
+            ++skipped;
+            continue;
+        }
+
+        row.country = parts.at(0);
+        row.city = parts.at(1);
+        row.capital = parts.at(2) == QLatin1String("True");
+
+        const QByteArray &countryKey = PlaceNames::countryKey(row.country).toUtf8();
+        const QByteArray &cityKey = PlaceNames::cityKey(row.city).toUtf8();
+        if (countryKey.isEmpty() || cityKey.isEmpty()) {
+            std::cerr << "Unnamed place on line " << lineNumber << " ignored: " << qPrintable(line) << std::endl;
+            ++skipped;
+            continue;
+        }
+
+        CountryRows &country = countries[countryKey];
+        if (country.name.isEmpty()) {
+            country.name = row.country;
+        }
+        // the latest duplicate wins, as it used to with QMultiMap::value()
+        country.cities.insert(cityKey, row);
+    }
+
+    Writer strings;
+    // the country names go first, so resolving a country touches few pages of the pool
+    for (auto country = countries.cbegin(); country != countries.cend(); ++country) {
+        strings.intern(QString::fromUtf8(country.key()));
+        strings.intern(country->name);
+    }
+
+    QByteArray countriesData;
+    QByteArray citiesData;
+    quint32 cityIndex(0);
+    for (auto country = countries.cbegin(); country != countries.cend(); ++country) {
+        CitiesDb::Country entry;
+        entry.key = strings.intern(QString::fromUtf8(country.key()));
+        entry.name = strings.intern(country->name);
+        entry.firstCity = cityIndex;
+        entry.cityCount = static_cast<quint32>(country->cities.size());
+        entry.capital = CitiesDb::NoCapital;
+
+        for (auto city = country->cities.cbegin(); city != country->cities.cend(); ++city, ++cityIndex) {
+            if (city->capital && entry.capital == CitiesDb::NoCapital) {
+                entry.capital = cityIndex;
+            }
+
+            CitiesDb::City cityEntry;
+            cityEntry.key = strings.intern(QString::fromUtf8(city.key()));
+            cityEntry.name = strings.intern(city->city);
+            cityEntry.latitude = city->latitude;
+            cityEntry.longitude = city->longitude;
+            cityEntry.flags = city->capital ? CitiesDb::Capital : 0;
+            appendRaw(citiesData, cityEntry);
+        }
+
+        appendRaw(countriesData, entry);
+    }
+
+    CitiesDb::Header header;
+    std::copy(std::begin(CitiesDb::Magic), std::end(CitiesDb::Magic), header.magic);
+    header.version = CitiesDb::FormatVersion;
+    header.countryCount = static_cast<quint32>(countries.size());
+    header.cityCount = cityIndex;
+    header.countriesOffset = sizeof(CitiesDb::Header);
+    header.citiesOffset = header.countriesOffset + static_cast<quint32>(countriesData.size());
+    header.stringsOffset = header.citiesOffset + static_cast<quint32>(citiesData.size());
+    header.stringsSize = static_cast<quint32>(strings.pool().size());
+
+    QByteArray image;
+    appendRaw(image, header);
+    image.append(countriesData);
+    image.append(citiesData);
+    image.append(strings.pool());
+    alignTo4(image);
+
+    QSaveFile out(args.at(2));
+    if (!out.open(QFile::WriteOnly) || out.write(image) != image.size() || !out.commit()) {
+        std::cerr << "Failed writing " << qPrintable(out.fileName()) << ": " << qPrintable(out.errorString())
+                  << std::endl;
+        return 3;
+    }
+
+    std::cout << "Compiled " << header.countryCount << " countries, " << header.cityCount << " cities ("
+              << skipped << " lines skipped) into " << image.size() << " bytes" << std::endl;
+    return 0;
+}